@@ -1,12 +1,13 @@
 BEGIN TRANSACTION;
 CREATE TABLE IF NOT EXISTS "transactions" (
+	"transaction_id"	INTEGER PRIMARY KEY AUTOINCREMENT,
 	"service_date"	INTEGER NOT NULL,
 	"filed_date"	INTEGER NOT NULL,
 	"provider_id"	INTEGER NOT NULL,
 	"member_id"	INTEGER NOT NULL,
 	"service_code"	INTEGER NOT NULL,
 	"comments"	TEXT,
-	PRIMARY KEY("filed_date"),
+	UNIQUE("filed_date","service_date","provider_id","member_id","service_code"),
 	FOREIGN KEY("service_code") REFERENCES "services"("code"),
 	FOREIGN KEY("provider_id") REFERENCES "accounts"("chocan_id"),
 	FOREIGN KEY("member_id") REFERENCES "accounts"("chocan_id")
@@ -39,11 +40,22 @@ CREATE TABLE IF NOT EXISTS "account_status" (
 	"status"	TEXT NOT NULL UNIQUE,
 	PRIMARY KEY("status")
 );
-INSERT INTO "transactions" VALUES (1574380800,1574380800,177607040,123123123,321321,'This dude is way too addicted to chocolate');
-INSERT INTO "transactions" VALUES (1574467200,1574467200,987654321,123412345,654321,'Wubba lubba dub dub');
-INSERT INTO "transactions" VALUES (1574554329,1574554329,123451234,123123123,123456,'Reccommend daily backrubs');
-INSERT INTO "transactions" VALUES (1575691233,1575691233,123451234,123123123,598470,'I dont know what im doing');
-INSERT INTO "transactions" VALUES (1575691235,1575691235,123451234,123123123,883948,'Lets get schwifty');
+CREATE TABLE IF NOT EXISTS "catalog_version" (
+	"version"	INTEGER NOT NULL
+);
+CREATE TABLE IF NOT EXISTS "accounts_version" (
+	"version"	INTEGER NOT NULL
+);
+CREATE INDEX IF NOT EXISTS "transactions_service_date" ON "transactions" ("service_date", "transaction_id");
+CREATE VIRTUAL TABLE IF NOT EXISTS "accounts_fts" USING fts5(
+	"f_name", "l_name", "street", "city", "state", "zip",
+	content='accounts', content_rowid='chocan_id', prefix='2 3'
+);
+INSERT INTO "transactions" VALUES (NULL,1574380800,1574380800,177607040,123123123,321321,'This dude is way too addicted to chocolate');
+INSERT INTO "transactions" VALUES (NULL,1574467200,1574467200,987654321,123412345,654321,'Wubba lubba dub dub');
+INSERT INTO "transactions" VALUES (NULL,1574554329,1574554329,123451234,123123123,123456,'Reccommend daily backrubs');
+INSERT INTO "transactions" VALUES (NULL,1575691233,1575691233,123451234,123123123,598470,'I dont know what im doing');
+INSERT INTO "transactions" VALUES (NULL,1575691235,1575691235,123451234,123123123,883948,'Lets get schwifty');
 INSERT INTO "accounts" VALUES (123123123,'John','Doe','1234 Cool St.','Portland','OR','97030','Member','Valid');
 INSERT INTO "accounts" VALUES (123412345,'Morty','Smith','137 Smith st.','Meeseeks','NJ','86453','Member','Valid');
 INSERT INTO "accounts" VALUES (123451234,'Vince','Feelgood','1989 Motley Crue ln.','Los Angeles','CA','90510','Provider','Valid');
@@ -63,4 +75,39 @@ INSERT INTO "account_type" VALUES ('Provider');
 INSERT INTO "account_type" VALUES ('Member');
 INSERT INTO "account_status" VALUES ('Valid');
 INSERT INTO "account_status" VALUES ('Suspended');
+INSERT INTO "catalog_version" VALUES (1);
+INSERT INTO "accounts_version" VALUES (1);
+INSERT INTO "accounts_fts"("accounts_fts") VALUES ('rebuild');
+CREATE TRIGGER IF NOT EXISTS "services_insert_version" AFTER INSERT ON "services" BEGIN
+	UPDATE "catalog_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "services_update_version" AFTER UPDATE ON "services" BEGIN
+	UPDATE "catalog_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "services_delete_version" AFTER DELETE ON "services" BEGIN
+	UPDATE "catalog_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_insert_version" AFTER INSERT ON "accounts" BEGIN
+	UPDATE "accounts_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_update_version" AFTER UPDATE ON "accounts" BEGIN
+	UPDATE "accounts_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_delete_version" AFTER DELETE ON "accounts" BEGIN
+	UPDATE "accounts_version" SET "version" = "version" + 1;
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_fts_insert" AFTER INSERT ON "accounts" BEGIN
+	INSERT INTO "accounts_fts"("rowid", "f_name", "l_name", "street", "city", "state", "zip")
+	VALUES (new."chocan_id", new."f_name", new."l_name", new."street", new."city", new."state", new."zip");
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_fts_delete" AFTER DELETE ON "accounts" BEGIN
+	INSERT INTO "accounts_fts"("accounts_fts", "rowid", "f_name", "l_name", "street", "city", "state", "zip")
+	VALUES ('delete', old."chocan_id", old."f_name", old."l_name", old."street", old."city", old."state", old."zip");
+END;
+CREATE TRIGGER IF NOT EXISTS "accounts_fts_update" AFTER UPDATE ON "accounts" BEGIN
+	INSERT INTO "accounts_fts"("accounts_fts", "rowid", "f_name", "l_name", "street", "city", "state", "zip")
+	VALUES ('delete', old."chocan_id", old."f_name", old."l_name", old."street", old."city", old."state", old."zip");
+	INSERT INTO "accounts_fts"("rowid", "f_name", "l_name", "street", "city", "state", "zip")
+	VALUES (new."chocan_id", new."f_name", new."l_name", new."street", new."city", new."state", new."zip");
+END;
 COMMIT;
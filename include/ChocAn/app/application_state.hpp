@@ -21,11 +21,14 @@ https://github.com/AlexanderJDupree/ChocAn
 #define CHOCAN_APPLICATION_STATE_H
 
 #include <variant>
+#include <algorithm>
 #include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/service_catalog.hpp>
 #include <ChocAn/core/entities/transaction.hpp>
 #include <ChocAn/core/entities/account_report.hpp>
 #include <ChocAn/core/utils/transaction_builder.hpp>
 #include <ChocAn/core/utils/account_builder.hpp>
+#include <ChocAn/core/utils/overloaded.hpp>
 
 class Menu 
 {
@@ -66,8 +69,12 @@ public:
                     , Gen_Member_Report
                     , Gen_Provider_Report };
 
+    // Most accounts a name or address search will list
+    static constexpr size_t max_matches = 10;
+
     Next next = Next::View_Account;
     std::string status = "";
+    Data_Gateway::Accounts matches = {};
 };
 
 class View_Account
@@ -100,7 +107,30 @@ public:
 class View_Report
 {
 public:
-    ChocAn_Report report;
+    // Reports can be large, states share a handle instead of copying them
+    using Report_Ptr = std::shared_ptr<const ChocAn_Report>;
+
+    // Provider activity or transaction rows shown per page
+    static constexpr size_t page_size = 20;
+
+    Report_Ptr report;
+    size_t page = 0;
+    std::string status = "";
+
+    // Number of provider activity rows in a summary, or transactions in an account report
+    size_t rows() const
+    {
+        return std::visit( overloaded {
+            [](const Summary_Report& report) { return report.activity().size(); },
+            [](const Account_Report& report) { return report.transactions().size(); }
+        }, *report );
+    }
+
+    // An empty report still has one page
+    size_t page_count() const
+    {
+        return std::max<size_t>(1, (rows() + page_size - 1) / page_size);
+    }
 };
 
 class Update_Account
@@ -123,7 +153,7 @@ public:
 class View_Service_Directory
 {
 public:
-    Data_Gateway::Database_Ptr db;
+    Service_Catalog::Catalog_Ptr catalog;
 };
 
 using Application_State = std::variant< Exit
@@ -22,6 +22,10 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <map>
 #include <vector>
 #include <string>
+#include <memory>
+#include <cctype>
+#include <optional>
+#include <algorithm>
 #include <functional>
 
 class Input_Controller
@@ -34,13 +38,41 @@ public:
 
     using Input_Control_Ptr = std::shared_ptr<Input_Controller>;
 
+    virtual ~Input_Controller() {}
+
     // Read a single line of input
     virtual std::string read_input() const = 0;
 
-    virtual std::optional<bool> confirm_input() const = 0;
+    // Reads a yes or no, empty if the input was neither
+    virtual std::optional<bool> confirm_input() const
+    {
+        std::string input = read_input();
+
+        std::for_each(input.begin(), input.end(), [](char& c)
+        {
+            c = std::tolower(c);
+        } );
+
+        if(input == "y" || input == "yes") { return true;  }
+        if(input == "n" || input == "no")  { return false;  }
+
+        return { };
+    }
 
     // Read a line of input for each field in fields
-    virtual Form_Data read_form(const Fields& fields, Field_Callback prompt) const = 0;
+    virtual Form_Data read_form(const Fields& fields, Field_Callback prompt) const
+    {
+        Form_Data form;
+
+        // Read input into each field
+        std::for_each( fields.begin(), fields.end(),
+                       [&](const std::string& field)
+                       {
+                           prompt(field);
+                           form[field] = read_input();
+                       } );
+        return form;
+    }
 };
 
 #endif // CHOCAN_INPUT_CONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+
+File: null_state_viewer.hpp
+
+Brief: Null State Viewer renders nothing. Each state's input handler runs as if
+       its prompt had been reached, so sessions can be driven headless.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_NULL_STATE_VIEWER_H
+#define CHOCAN_NULL_STATE_VIEWER_H
+
+#include <ChocAn/app/state_viewer.hpp>
+
+class Null_State_Viewer : public State_Viewer
+{
+public:
+
+    void update() override
+    {
+        event_callback();
+    }
+
+    void render_state(const Application_State&, Callback event = [](){}) override
+    {
+        event_callback = event;
+
+        update();
+    }
+
+private:
+
+    Callback event_callback = [](){};
+};
+
+#endif // CHOCAN_NULL_STATE_VIEWER_H
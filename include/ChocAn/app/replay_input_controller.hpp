@@ -0,0 +1,98 @@
+/*
+
+File: replay_input_controller.hpp
+
+Brief: Replay Input Controller feeds a session written by Session Recorder back
+       into the application, either at the pace it was recorded or as fast as
+       the application will take it. The end of the session reads as "exit".
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_REPLAY_INPUT_CONTROLLER_H
+#define CHOCAN_REPLAY_INPUT_CONTROLLER_H
+
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <istream>
+#include <ChocAn/app/input_controller.hpp>
+
+class Replay_Input_Controller : public Input_Controller
+{
+public:
+
+    using Clock    = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    enum class Pace { Recorded, Fast };
+
+    // The stream must outlive the controller
+    Replay_Input_Controller(std::istream& session, Pace pace = Pace::Fast)
+        : session ( session )
+        , pace    ( pace )
+        , start   ( Clock::now() )
+        { }
+
+    std::string read_input() const override
+    {
+        std::string line;
+        while(std::getline(session, line))
+        {
+            size_t offset_end = line.find('\t');
+            size_t state_end  = (offset_end == std::string::npos) ? offset_end : line.find('\t', offset_end + 1);
+
+            // Lines that are not session records are skipped
+            if(state_end == std::string::npos) { continue; }
+
+            recorded_state = line.substr(offset_end + 1, state_end - offset_end - 1);
+            ++lines_read;
+
+            if(pace == Pace::Recorded)
+            {
+                wait_until(Duration(std::strtoll(line.c_str(), nullptr, 10)));
+            }
+            return line.substr(state_end + 1);
+        }
+        return "exit";
+    }
+
+    // State that read the last line when it was recorded
+    const std::string& last_recorded_state() const { return recorded_state; }
+
+    // Time spent holding input back to match the recorded pace, offsets count from construction
+    Duration waited() const { return total_wait; }
+
+    unsigned long long lines() const { return lines_read; }
+
+private:
+
+    void wait_until(Duration offset) const
+    {
+        Clock::time_point now = Clock::now();
+        Clock::time_point due = start + offset;
+        if(due > now)
+        {
+            std::this_thread::sleep_until(due);
+            total_wait += std::chrono::duration_cast<Duration>(Clock::now() - now);
+        }
+    }
+
+    std::istream&     session;
+    Pace              pace;
+    Clock::time_point start;
+
+    mutable std::string        recorded_state;
+    mutable unsigned long long lines_read = 0;
+    mutable Duration           total_wait { 0 };
+};
+
+#endif // CHOCAN_REPLAY_INPUT_CONTROLLER_H
@@ -0,0 +1,64 @@
+/*
+
+File: scripted_input_controller.hpp
+
+Brief: Scripted Input Controller plays lines of input from scripts handed to it
+       one at a time, so a simulated session can drive a State Controller
+       without a terminal. Once there are no more scripts it reads "exit".
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_SCRIPTED_INPUT_CONTROLLER_H
+#define CHOCAN_SCRIPTED_INPUT_CONTROLLER_H
+
+#include <deque>
+#include <vector>
+#include <ChocAn/app/input_controller.hpp>
+
+class Scripted_Input_Controller : public Input_Controller
+{
+public:
+
+    using Script = std::vector<std::string>;
+
+    // Called whenever the current script is used up, an empty script ends the session
+    using Next_Script = std::function<Script()>;
+
+    explicit Scripted_Input_Controller(Next_Script next_script)
+        : next_script ( std::move(next_script) )
+        { }
+
+    std::string read_input() const override
+    {
+        if(lines.empty() && !finished)
+        {
+            Script script = next_script();
+
+            finished = script.empty();
+            lines.assign(script.begin(), script.end());
+        }
+        if(lines.empty()) { return "exit"; }
+
+        std::string line = std::move(lines.front());
+        lines.pop_front();
+        return line;
+    }
+
+private:
+
+    Next_Script next_script;
+
+    mutable std::deque<std::string> lines;
+    mutable bool                    finished = false;
+};
+
+#endif // CHOCAN_SCRIPTED_INPUT_CONTROLLER_H
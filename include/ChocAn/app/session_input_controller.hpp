@@ -0,0 +1,93 @@
+/*
+
+File: session_input_controller.hpp
+
+Brief: Session Input Controller hands a session the lines fed to it from
+       elsewhere, a connection or a test. Reading with no line queued parks the
+       session's fiber when it runs on a Session_Scheduler, and blocks the
+       calling thread otherwise.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_SESSION_INPUT_CONTROLLER_H
+#define CHOCAN_SESSION_INPUT_CONTROLLER_H
+
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <condition_variable>
+#include <ChocAn/app/input_controller.hpp>
+#include <ChocAn/app/session_scheduler.hpp>
+
+class Session_Input_Controller : public Input_Controller
+{
+public:
+
+    // Queues a line and wakes the session if it is waiting for one. Safe from any thread
+    void feed(std::string line)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        lines.push_back(std::move(line));
+        resume(guard);
+    }
+
+    // Once the queued lines are read, every read returns "exit"
+    void close()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        closed = true;
+        resume(guard);
+    }
+
+    // A single session reads from the controller
+    std::string read_input() const override
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while(lines.empty() && !closed)
+        {
+            parked = Session_Scheduler::current();
+            if(!parked)
+            {
+                arrived.wait(guard);
+                continue;
+            }
+            guard.unlock();
+            Session_Scheduler::park();
+            guard.lock();
+        }
+        if(lines.empty()) { return "exit"; }
+
+        std::string line = std::move(lines.front());
+        lines.pop_front();
+        return line;
+    }
+
+private:
+
+    // Each park is matched by exactly one wake, the reader re-registers if it parks again
+    void resume(std::unique_lock<std::mutex>& guard)
+    {
+        Session_Scheduler::Fiber* fiber = std::exchange(parked, nullptr);
+        guard.unlock();
+
+        if(fiber) { Session_Scheduler::wake(fiber); }
+        else      { arrived.notify_one(); }
+    }
+
+    mutable std::mutex                lock;
+    mutable std::condition_variable   arrived;
+    mutable std::deque<std::string>   lines;
+    mutable Session_Scheduler::Fiber* parked = nullptr;
+    bool                              closed = false;
+};
+
+#endif // CHOCAN_SESSION_INPUT_CONTROLLER_H
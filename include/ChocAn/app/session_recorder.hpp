@@ -0,0 +1,71 @@
+/*
+
+File: session_recorder.hpp
+
+Brief: Session Recorder decorates an input controller so that every line of
+       input is written to a session file, along with when it was read and the
+       state that read it. Sessions are replayed by Replay Input Controller.
+
+       Each line of a session is: <microseconds since start>\t<state>\t<input>
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_SESSION_RECORDER_H
+#define CHOCAN_SESSION_RECORDER_H
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <ChocAn/app/input_controller.hpp>
+
+class Session_Recorder : public Input_Controller
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+    using Session_Recorder_Ptr = std::shared_ptr<Session_Recorder>;
+
+    // The stream must outlive the recorder
+    Session_Recorder(Input_Control_Ptr input_controller, std::ostream& session)
+        : input_controller ( input_controller )
+        , session          ( session )
+        , start            ( Clock::now() )
+        { }
+
+    // Called by the state controller before each state runs
+    void enter_state(const char* state) { current_state = state; }
+
+    std::string read_input() const override
+    {
+        return record(input_controller->read_input());
+    }
+
+    // Confirmations and forms read through read_input, so every line is recorded
+
+private:
+
+    std::string record(std::string input) const
+    {
+        auto offset = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+        // Flushed per line so a session survives the terminal being closed
+        session << offset.count() << '\t' << current_state << '\t' << input << std::endl;
+        return input;
+    }
+
+    Input_Control_Ptr input_controller;
+    std::ostream&     session;
+    Clock::time_point start;
+    const char*       current_state = "";
+};
+
+#endif // CHOCAN_SESSION_RECORDER_H
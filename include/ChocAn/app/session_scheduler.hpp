@@ -0,0 +1,106 @@
+/*
+
+File: session_scheduler.hpp
+
+Brief: Session Scheduler runs each session on its own fiber and multiplexes
+       the fibers over a few worker threads. A session that waits for input
+       parks its fiber rather than its thread, so the unchanged State_Controller
+       handlers can run thousands of sessions without a thread apiece.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_SESSION_SCHEDULER_H
+#define CHOCAN_SESSION_SCHEDULER_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+class Session_Scheduler
+{
+public:
+
+    using Session = std::function<void()>;
+
+    class Fiber;
+
+    static constexpr size_t default_stack_size = 256 * 1024;
+
+    explicit Session_Scheduler(unsigned threads = 1, size_t stack_size = default_stack_size);
+
+    // Thrown from park and yield in a session still running when the scheduler is destroyed,
+    // so its stack unwinds. It is not a std::exception, sessions should let it propagate
+    struct Cancelled { };
+
+    // Stops the workers. Before it exits, each worker cancels the sessions started on it that
+    // have not returned, so the objects on their stacks are destroyed on the thread they ran
+    // on. Sessions that never started are dropped. Inputs must stop waking sessions before
+    // the scheduler is destroyed
+    ~Session_Scheduler();
+
+    Session_Scheduler(const Session_Scheduler&) = delete;
+    Session_Scheduler& operator=(const Session_Scheduler&) = delete;
+
+    // Starts session on a fiber of its own. A fiber stays on the worker it starts on, so
+    // thread local state is stable across parks
+    void spawn(Session session);
+
+    // Blocks until every session has returned, then rethrows the first exception one threw
+    void wait();
+
+    // Sessions that have not yet returned
+    size_t sessions() const;
+
+    /* Called from within a session. Exception handling state is per thread, so a
+       session must not park or yield while inside a catch block */
+
+    // The fiber of the running session, nullptr off the scheduler
+    static Fiber* current();
+
+    // Suspends the running session until wake is called for its fiber. A wake that comes
+    // before the park is kept, the session then resumes straight away
+    static void park();
+
+    // Lets the worker run its other sessions before this one continues
+    static void yield();
+
+    // Resumes a parked fiber, from any thread. Each park must be matched by one wake
+    static void wake(Fiber* fiber);
+
+private:
+
+    struct Worker;
+
+    static void run_fiber();
+    static void switch_out();
+
+    void worker_loop(Worker& worker);
+
+    // Resumes each started session of a stopping worker with Cancelled, until it returns
+    void cancel_sessions(Worker& worker);
+    void finish(std::exception_ptr error);
+
+    size_t stack_size;
+    size_t next_worker = 0;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    mutable std::mutex      lock;
+    std::condition_variable idle;
+    size_t                  live = 0;
+    std::exception_ptr      first_error;
+};
+
+#endif // CHOCAN_SESSION_SCHEDULER_H
@@ -19,12 +19,16 @@ https://github.com/AlexanderJDupree/ChocAn
 #ifndef  CHOCAN_STATE_CONTROLLER_H
 #define  CHOCAN_STATE_CONTROLLER_H
 
-#include <map>
-#include <stack>
+#include <utility>
+#include <ostream>
+#include <string_view>
 #include <functional>
 #include <ChocAn/core/chocan.hpp>
+#include <ChocAn/core/utils/tracer.hpp>
+#include <ChocAn/core/utils/ring_buffer.hpp>
 #include <ChocAn/app/state_viewer.hpp>
 #include <ChocAn/app/input_controller.hpp>
+#include <ChocAn/app/session_recorder.hpp>
 #include <ChocAn/app/application_state.hpp>
 
 class State_Controller
@@ -32,10 +36,17 @@ class State_Controller
 public:
 
     using ChocAn_Ptr        = ChocAn::ChocAn_Ptr;
-    using Runtime_Stack     = std::stack<Application_State>;
+    // Menus are at most a few states deep, the oldest history is dropped past this
+    static constexpr size_t max_history = 16;
+
+    using Runtime_Stack     = Ring_Buffer<Application_State, max_history>;
     using State_Viewer_Ptr  = State_Viewer::State_Viewer_Ptr;
     using Input_Control_Ptr = Input_Controller::Input_Control_Ptr;
-    using Transition_Table  = std::map<std::string, std::function<Application_State()>>;
+    using Recorder_Ptr      = Session_Recorder::Session_Recorder_Ptr;
+
+    // Menus are fixed tables of input to transition, so visiting a menu allocates nothing
+    using Transition        = Application_State (*)(State_Controller&);
+    using Menu_Entry        = std::pair<std::string_view, Transition>;
 
     // TODO set default instances
     State_Controller( ChocAn_Ptr        chocan
@@ -49,6 +60,14 @@ public:
 
     bool end_state() const;
 
+    // Records a span for each interaction and for each wait on user input
+    void enable_tracing(Tracer::Tracer_Ptr tracer);
+
+    // Writes each line of input to session along with the state that read it
+    void enable_recording(std::ostream& session);
+
+    static const char* state_name(const Application_State& state);
+
     /** Visitor Methods **/
     Application_State operator()(Exit&);
     Application_State operator()(Login&);
@@ -73,6 +92,8 @@ private:
     State_Viewer_Ptr   state_viewer;
     Input_Control_Ptr  input_controller;
     Runtime_Stack      runtime;
+    Tracer::Tracer_Ptr tracer;
+    Recorder_Ptr       recorder;
     bool               is_end_state = false;
 
 };
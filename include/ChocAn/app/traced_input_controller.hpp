@@ -0,0 +1,59 @@
+/*
+
+File: traced_input_controller.hpp
+
+Brief: Traced Input Controller decorates an input controller so that the time
+       spent waiting on the user is recorded as a trace span.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_TRACED_INPUT_CONTROLLER_H
+#define CHOCAN_TRACED_INPUT_CONTROLLER_H
+
+#include <optional>
+#include <ChocAn/core/utils/tracer.hpp>
+#include <ChocAn/app/input_controller.hpp>
+
+class Traced_Input_Controller : public Input_Controller
+{
+public:
+
+    Traced_Input_Controller(Input_Control_Ptr input_controller, Tracer::Tracer_Ptr tracer)
+        : input_controller ( input_controller )
+        , tracer           ( tracer )
+        { }
+
+    std::string read_input() const override
+    {
+        Tracer::Span span(tracer.get(), "read_input", "input");
+        return input_controller->read_input();
+    }
+
+    std::optional<bool> confirm_input() const override
+    {
+        Tracer::Span span(tracer.get(), "confirm_input", "input");
+        return input_controller->confirm_input();
+    }
+
+    Form_Data read_form(const Fields& fields, Field_Callback prompt) const override
+    {
+        Tracer::Span span(tracer.get(), "read_form", "input");
+        return input_controller->read_form(fields, prompt);
+    }
+
+private:
+
+    Input_Control_Ptr  input_controller;
+    Tracer::Tracer_Ptr tracer;
+};
+
+#endif // CHOCAN_TRACED_INPUT_CONTROLLER_H
@@ -0,0 +1,55 @@
+/*
+
+File: transition_metrics.hpp
+
+Brief: Transition Metrics keeps a latency histogram for each state transition,
+       so replays of recorded sessions can be compared between builds.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_TRANSITION_METRICS_H
+#define CHOCAN_TRANSITION_METRICS_H
+
+#include <map>
+#include <string>
+#include <ChocAn/core/utils/latency_histogram.hpp>
+
+class Transition_Metrics
+{
+public:
+
+    using Duration         = Latency_Histogram::Duration;
+    using Transition       = std::pair<std::string, std::string>;
+    using Transition_Table = std::map<Transition, Latency_Histogram>;
+
+    void record(const std::string& from, const std::string& to, Duration elapsed);
+
+    // Folds in metrics gathered elsewhere, such as by another session
+    void merge(const Transition_Metrics& other);
+
+    // Number of transitions recorded
+    unsigned long long count() const;
+
+    // Latency of every transition out of a state, whatever state followed
+    Latency_Histogram from(const std::string& state) const;
+
+    const Transition_Table& transitions() const { return table; }
+
+    // Per transition count, mean, p50, p99, p99.9, and max in microseconds
+    std::string report() const;
+
+private:
+
+    Transition_Table table;
+};
+
+#endif // CHOCAN_TRANSITION_METRICS_H
@@ -19,16 +19,25 @@ https://github.com/AlexanderJDupree/ChocAn
 #define CHOCAN_DATA_GATEWAY_HPP
 
 #include <map>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <memory>
+#include <string>
 #include <optional>
+#include <ChocAn/core/utils/codecs.hpp>
+#include <ChocAn/core/utils/cursor.hpp>
+#include <ChocAn/core/utils/result.hpp>
 #include <ChocAn/core/utils/passkey.hpp>
+#include <ChocAn/core/utils/tracer.hpp>
 
 // Forward Declare
 class Account;
 class Service;
 class DateTime;
+class ID_Index;
 class Transaction;
+class Service_Catalog;
 
 class Data_Gateway
 {
@@ -39,6 +48,61 @@ public:
     using Transactions      = std::vector<Transaction>;
     using Accounts          = std::vector<Account>;
 
+    using Account_Cursor     = Cursor<Account>;
+    using Transaction_Cursor = Cursor<Transaction>;
+
+    // Projections for paths that only need keys and totals. They are read as typed columns
+    // and leave out the names, addresses, and comments whole entities carry
+    struct Transaction_Summary
+    {
+        unsigned provider_id  = 0;
+        unsigned member_id    = 0;
+        unsigned service_code = 0;
+        long     service_date = 0;
+        long     filed_date   = 0;
+        double   cost         = 0; // Service cost, as get_transactions reports it
+    };
+
+    struct Account_Header
+    {
+        unsigned             id     = 0;
+        Codecs::Account_Kind kind   = Codecs::Account_Kind::Member;
+        Account_Status       status = Account_Status::Valid;
+    };
+
+    using Transaction_Summaries = std::vector<Transaction_Summary>;
+    using Header_Cursor         = Cursor<Account_Header>;
+
+    // Describes a write, so caches built over the data can drop only what it touched
+    struct Change
+    {
+        enum class Kind { Account, Service, Transaction };
+
+        Kind     kind;
+        unsigned id           = 0;     // Account ID, service code, or transaction number
+        bool     provider     = false; // Account changes: the account is, or was, a provider
+        unsigned provider_id  = 0;     // Transaction changes only
+        unsigned member_id    = 0;
+        int      service_date = 0;
+
+        // Account changes: the kind and status written, no kind if the account was deleted
+        std::optional<Codecs::Account_Kind> account_kind = { };
+        Account_Status                      status = Account_Status::Valid;
+    };
+
+    class Observer
+    {
+    public:
+        virtual ~Observer() {}
+        virtual void on_change(const Change& change) = 0;
+    };
+
+    Data_Gateway() = default;
+
+    // A copy builds its own ID index rather than writing to the original's
+    Data_Gateway(const Data_Gateway& other);
+    Data_Gateway& operator=(const Data_Gateway& other);
+
     virtual ~Data_Gateway() {}
 
     // Updates fields of specific accounts, creates account if account DNE
@@ -68,21 +132,115 @@ public:
     virtual std::optional<Service> lookup_service(const unsigned code) = 0;
     virtual std::optional<Service> lookup_service(const std::string& code) = 0;
 
+    // Parse user input without throwing and report why a lookup failed: Malformed_Number,
+    // Not_Found, or Wrong_Type when the account exists but is not of the requested kind
+    Result<Account> find_account(const std::string& ID);
+    Result<Account> find_account(const std::string& ID, Codecs::Account_Kind kind);
+    Result<Service> find_service(const std::string& code);
+
     virtual Transactions get_transactions(DateTime start, DateTime end, Account acct) = 0;
     virtual Transactions get_transactions(DateTime start, DateTime end) = 0;
 
     virtual Accounts get_member_accounts()   = 0;
     virtual Accounts get_provider_accounts() = 0;
+    virtual Accounts get_manager_accounts()  = 0;
+
+    // Cursors fetch rows lazily in key order (accounts by ID, transactions by service date),
+    // resuming each batch after the last key returned. A cursor must not outlive its gateway
+    virtual Account_Cursor scan_member_accounts()   = 0;
+    virtual Account_Cursor scan_provider_accounts() = 0;
+    virtual Account_Cursor scan_manager_accounts()  = 0;
+
+    virtual Transaction_Cursor scan_transactions(DateTime start, DateTime end, Account acct) = 0;
+    virtual Transaction_Cursor scan_transactions(DateTime start, DateTime end) = 0;
+
+    // Every transaction get_transactions(start, end) returns, in service date order
+    virtual Transaction_Summaries transaction_summaries(DateTime start, DateTime end) = 0;
+
+    static Transaction_Summary summarize(const Transaction& transaction);
+
+    virtual std::optional<Account_Header> account_header(const unsigned ID) = 0;
+
+    // Headers of every account in ID order
+    virtual Header_Cursor scan_account_headers() = 0;
+
+    // Ranked search over account names and addresses, every query term must prefix a word
+    virtual Accounts search_accounts(const std::string& query, size_t limit) = 0;
 
     virtual Service_Directory service_directory() = 0;
 
+    // Changes whenever a service is added, updated, or removed
+    virtual unsigned long services_version() = 0;
+
+    // Catalog of the service directory, shared by every gateway in the process onto the same
+    // store and rebuilt only when the services version changes
+    std::shared_ptr<const Service_Catalog> service_catalog();
+
+    // Identifies the store behind this gateway, gateways onto the same store share caches.
+    // Unique to each gateway unless the store can be opened by more than one
+    virtual std::string store_id() const;
+
     virtual bool id_exists(const unsigned ID) const = 0;
 
+    // Bitmaps of account IDs, members, and suspended members. Built on first use and kept
+    // current by account writes through this gateway. Writes by other connections are picked
+    // up by checking the store's versions, at most once per refresh interval, so lookups in
+    // between never query the store
+    const ID_Index& id_index();
+
+    // How stale the ID index may be with respect to other connections, 0 checks on every lookup
+    void set_id_index_refresh(std::chrono::milliseconds refresh) { ids_refresh = refresh; }
+
+    // Member status from the ID index. Callers that go on to read the account should check
+    // its status there, another connection may have changed it within the refresh interval
+    Result<Account_Status> member_status(const unsigned ID);
+
+    // Changes whenever any connection creates, updates, or deletes an account. Stores
+    // with a single writer return 0, their index is kept current by their own writes
+    virtual unsigned long accounts_version() { return 0; }
+
+    // Observers are told of each write made through this gateway, expired observers are dropped
+    void subscribe(std::weak_ptr<Observer> observer);
+
+    // Changes whenever another connection writes to the same store, writes by other
+    // connections are not reported to observers. Stores with a single writer return 0
+    virtual unsigned long external_version() { return 0; }
+
+    // Records a span, in the "db" category, for each statement or log write the store makes
+    void set_tracer(Tracer::Tracer_Ptr tracer) { this->tracer = std::move(tracer); }
+
 protected:
 
+    void notify(const Change& change);
+
+    // For stores whose contents are replaced wholesale, the index is rebuilt on next use
+    void reset_id_index() { ids.reset(); }
+
+    static Change account_change(const Account& account);
+    static Change transaction_change(const Transaction& transaction, unsigned number);
+
     // Used for de-serializing domain entities
     Key<Data_Gateway> db_key;
 
+    Tracer::Tracer_Ptr tracer;
+
+private:
+
+    // Holds this gateway's catalog, the process wide cache only holds weak references
+    std::shared_ptr<const Service_Catalog> catalog;
+
+    unsigned long instance = ++instances;
+
+    static inline std::atomic<unsigned long> instances { 0 };
+
+    // External version when the ID index was built or last known to be current
+    std::shared_ptr<ID_Index>             ids;
+    unsigned long                         ids_external_version = 0;
+    std::chrono::steady_clock::time_point ids_checked;
+    std::chrono::milliseconds             ids_refresh = std::chrono::seconds(1);
+
+    std::vector<std::weak_ptr<Observer>> observers;
+
 };
 
 #endif // CHOCAN_DATA_GATEWAY_HPP
\ No newline at end of file
@@ -21,13 +21,12 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <memory>
 #include <variant>
 #include <ChocAn/core/id_generator.hpp> 
+#include <ChocAn/core/utils/codecs.hpp>
 #include <ChocAn/core/utils/passkey.hpp>
 #include <ChocAn/core/entities/name.hpp>
 #include <ChocAn/core/entities/address.hpp>
 #include <ChocAn/core/utils/serializable.hpp>
 
-enum class Account_Status { Valid, Suspended };
-
 class Provider {};
 
 class Manager  
@@ -80,6 +79,9 @@ public:
 
     Account( const Data_Table&, const Key<Data_Gateway>& );
 
+    // Checks a row's columns, IDs, and type before hydrating it, a malformed row is Malformed_Row
+    static Result<Account> decode( const Data_Table&, const Key<Data_Gateway>& );
+
     virtual ~Account() = default;
 
     /* Serializable Interface */
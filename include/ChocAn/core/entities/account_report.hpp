@@ -19,6 +19,7 @@ https://github.com/AlexanderJDupree/ChocAn
 #define CHOCAN_ACCOUNT_REPORT_HPP
 
 #include <vector>
+#include <ChocAn/core/data_gateway.hpp>
 #include <ChocAn/core/entities/account.hpp>
 #include <ChocAn/core/entities/transaction.hpp>
 
@@ -61,11 +62,36 @@ public:
     unsigned services_rendered() const;
 };
 
+// A provider's line of a summary. Only totals are shown, so claims are kept as transaction
+// summaries rather than whole transactions
+class Provider_Summary
+{
+public:
+
+    using Claims = Data_Gateway::Transaction_Summaries;
+
+    Provider_Summary(const Account& account, const Claims& claims);
+
+    // Condenses a full provider report
+    Provider_Summary(const Provider_Report& report);
+
+    const Account& account() const { return _account; }
+    const Claims&  claims()  const { return _claims;  }
+
+    USD total_fee() const;
+    unsigned services_rendered() const;
+
+private:
+
+    Account _account;
+    Claims  _claims;
+};
+
 class Summary_Report
 {
 public:
 
-    using Provider_Activity = std::vector<Provider_Report>;
+    using Provider_Activity = std::vector<Provider_Summary>;
 
     Summary_Report( const DateTime& start
                   , const DateTime& end
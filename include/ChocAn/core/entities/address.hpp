@@ -18,7 +18,6 @@ https://github.com/AlexanderJDupree/ChocAn
 #ifndef CHOCAN_ADDRESS_HPP
 #define CHOCAN_ADDRESS_HPP
 
-#include <set>
 #include <vector>
 #include <ChocAn/core/utils/exception.hpp>
 
@@ -45,8 +44,6 @@ private:
     std::string _city;
     std::string _state;
     unsigned _zip;
-
-    static const std::set<std::string> US_states;
 };
 
 struct invalid_address : public chocan_user_exception
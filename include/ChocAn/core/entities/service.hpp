@@ -59,6 +59,21 @@ public:
         , _code( std::stoi(data.at("code")) )
         , _name( data.at("name") )
         { }
+
+    // Checks a row's code and cost before hydrating it, a malformed row is Malformed_Row
+    static Result<Service> decode(const Data_Table& data, const Key<Data_Gateway>& key)
+    {
+        auto name = data.find("name");
+        auto code = data.find("code");
+        auto cost = data.find("cost");
+        if(name == data.end() || code == data.end() || cost == data.end()) { return Error_Code::Malformed_Row; }
+
+        Result<unsigned> number = Codecs::decode_id(code->second);
+        Result<double>   price  = Codecs::decode_number<double>(cost->second);
+        if(!number || !price) { return Error_Code::Malformed_Row; }
+
+        return Service(number.value(), price.value(), name->second, key);
+    }
     
     virtual ~Service() = default;
 
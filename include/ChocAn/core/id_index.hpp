@@ -0,0 +1,60 @@
+/*
+
+File: id_index.hpp
+
+Brief: ID Index answers whether an account ID exists, and whether it is a valid
+       or suspended member, from compressed bitmaps held in memory. Each
+       Data_Gateway builds one on first use and keeps it current with its own
+       account writes.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_ID_INDEX_HPP
+#define CHOCAN_ID_INDEX_HPP
+
+#include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/utils/id_bitmap.hpp>
+
+class ID_Index
+{
+public:
+
+    // Scans every account of the gateway, version is its accounts version before the scan
+    ID_Index(Data_Gateway& db, unsigned long version);
+
+    bool exists(unsigned ID) const { return ids.contains(ID); }
+
+    // Not_Found if there is no account with the ID, Wrong_Type if it is not a member
+    Result<Account_Status> member_status(unsigned ID) const;
+
+    // Applies an account change, any other change is ignored
+    void apply(const Data_Gateway::Change& change);
+
+    // Accounts version of the store the index reflects
+    unsigned long version() const { return _version; }
+    void set_version(unsigned long version) { _version = version; }
+
+    size_t size()  const { return ids.size(); }
+    size_t bytes() const { return ids.bytes() + members.bytes() + suspended.bytes(); }
+
+private:
+
+    void put(unsigned ID, Codecs::Account_Kind kind, Account_Status status);
+
+    ID_Bitmap ids;
+    ID_Bitmap members;
+    ID_Bitmap suspended;
+
+    unsigned long _version;
+};
+
+#endif // CHOCAN_ID_INDEX_HPP
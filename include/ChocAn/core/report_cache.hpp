@@ -0,0 +1,85 @@
+/*
+
+File: report_cache.hpp
+
+Brief: Report cache holds finished reports keyed by report type, account, and
+       date range. It observes the database and drops only the reports a write
+       could have changed: a transaction dated inside a cached range, or an
+       account or service that appears in a cached report.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_REPORT_CACHE_HPP
+#define CHOCAN_REPORT_CACHE_HPP
+
+#include <map>
+#include <tuple>
+#include <memory>
+#include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/entities/account_report.hpp>
+
+class Report_Cache : public Data_Gateway::Observer
+{
+public:
+
+    using Report_Ptr = std::shared_ptr<const ChocAn_Report>;
+    using Change     = Data_Gateway::Change;
+
+    enum class Report_Type { Member, Provider, Summary };
+
+    // Summary reports have no account, their key uses account 0
+    struct Key
+    {
+        Report_Type type;
+        unsigned    account;
+        int         start;
+        int         end;
+
+        bool operator<(const Key& rhs) const
+        {
+            return std::tie(type, account, start, end) < std::tie(rhs.type, rhs.account, rhs.start, rhs.end);
+        }
+    };
+
+    static constexpr size_t default_capacity = 64;
+
+    explicit Report_Cache(size_t capacity = default_capacity);
+
+    // Returns null on a miss
+    Report_Ptr find(const Key& key);
+
+    // Evicts the least recently used report once the cache is full
+    void insert(const Key& key, Report_Ptr report);
+
+    void clear();
+
+    size_t size() const { return entries.size(); }
+
+    void on_change(const Change& change) override;
+
+private:
+
+    struct Entry
+    {
+        Report_Ptr    report;
+        unsigned long last_used;
+    };
+
+    bool invalidated_by(const Key& key, const Entry& entry, const Change& change) const;
+
+    std::map<Key, Entry> entries;
+
+    size_t        capacity;
+    unsigned long clock = 0;
+};
+
+#endif // CHOCAN_REPORT_CACHE_HPP
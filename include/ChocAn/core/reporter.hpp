@@ -20,6 +20,7 @@ https://github.com/AlexanderJDupree/ChocAn
 #define CHOCAN_REPORTER_HPP
 
 #include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/report_cache.hpp>
 #include <ChocAn/core/entities/datetime.hpp>
 #include <ChocAn/core/entities/account_report.hpp>
 
@@ -28,6 +29,7 @@ class Reporter
 public:
 
     using Database_Ptr = Data_Gateway::Database_Ptr;
+    using Report_Ptr   = Report_Cache::Report_Ptr;
 
     Reporter(Database_Ptr db);
 
@@ -37,10 +39,26 @@ public:
 
     Member_Report gen_member_report(const DateTime& start, const DateTime& end, const Account& member) const;
 
+    // Cached reports, shared until a write changes what they would show
+    Report_Ptr summary_report(const DateTime& start, const DateTime& end);
+    Report_Ptr provider_report(const DateTime& start, const DateTime& end, const Account& provider);
+    Report_Ptr member_report(const DateTime& start, const DateTime& end, const Account& member);
+
+    const Report_Cache& cache() const { return *_cache; }
+
 private:
 
+    template <typename Generate>
+    Report_Ptr cached(const Report_Cache::Key& key, Generate generate);
+
     Database_Ptr db;
 
+    std::shared_ptr<Report_Cache> _cache;
+
+    // Writes the cache is not told of, a change in either clears it
+    unsigned long external_version = 0;
+    unsigned long services_version = 0;
+
 };
 
 
@@ -0,0 +1,84 @@
+/*
+
+File: service_catalog.hpp
+
+Brief: Service Catalog is an immutable snapshot of the service directory with
+       prebuilt code and name orderings, and name search indexes. Catalogs are
+       shared, not copied, between sessions and renders, and replaced only when
+       the services version reported by the Data_Gateway changes.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_SERVICE_CATALOG_HPP
+#define CHOCAN_SERVICE_CATALOG_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/entities/service.hpp>
+
+class Service_Catalog
+{
+public:
+
+    using Catalog_Ptr = std::shared_ptr<const Service_Catalog>;
+    using Services    = std::vector<Service>;
+
+    Service_Catalog(const Data_Gateway::Service_Directory& directory, unsigned long version);
+
+    // Services version of the directory this catalog was built from
+    unsigned long version() const { return _version; }
+
+    size_t size() const { return _by_code.size(); }
+
+    const Services& by_code() const { return _by_code; }
+    const Services& by_name() const { return _by_name; }
+
+    std::optional<Service> lookup(unsigned code) const;
+
+    // Services with a name, or a word within it, starting with prefix. In name order
+    Services prefix_search(const std::string& prefix, size_t limit = 10) const;
+
+    // Services ranked by trigram similarity of their name to query, tolerates typos
+    Services fuzzy_search(const std::string& query, size_t limit = 10) const;
+
+    // Prefix matches first, then fuzzy matches
+    Services search(const std::string& query, size_t limit = 10) const;
+
+    // Lower cases and collapses whitespace, names are compared in this form
+    static std::string fold(const std::string& name);
+
+    static constexpr double min_similarity = 0.3;
+
+private:
+
+    using Posting_List = std::vector<uint32_t>;
+
+    static std::vector<std::string> trigrams(const std::string& folded);
+
+    unsigned long _version;
+
+    Services _by_code;
+    Services _by_name;
+
+    // Folded name suffixes starting at each word, paired with their position in _by_name
+    std::vector<std::pair<std::string, uint32_t>> word_index;
+
+    // Trigram -> positions in _by_name, and the number of distinct trigrams in each name
+    std::unordered_map<std::string, Posting_List> trigram_index;
+    std::vector<uint32_t> trigram_counts;
+};
+
+#endif // CHOCAN_SERVICE_CATALOG_HPP
@@ -0,0 +1,159 @@
+/*
+
+File: codecs.hpp
+
+Brief: Codecs for the string encoded fields of an account: its ID, its
+       type, its status, and its US state code. Shared by DB hydration,
+       serialization, and validation so none of them build lookup tables.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_CODECS_HPP
+#define CHOCAN_CODECS_HPP
+
+#include <array>
+#include <cstdint>
+#include <charconv>
+#include <string>
+#include <optional>
+#include <string_view>
+#include <ChocAn/core/utils/result.hpp>
+
+enum class Account_Status { Valid, Suspended };
+
+namespace Codecs
+{
+
+// Order matches the alternatives of Account::Account_Type
+enum class Account_Kind : uint8_t { Manager, Member, Provider };
+
+constexpr std::string_view encode(Account_Kind kind)
+{
+    switch (kind)
+    {
+    case Account_Kind::Manager  : return "Manager";
+    case Account_Kind::Member   : return "Member";
+    case Account_Kind::Provider : return "Provider";
+    }
+    return "";
+}
+
+constexpr std::optional<Account_Kind> decode_account_kind(std::string_view name)
+{
+    // Every name has a distinct length, so a single comparison decides
+    switch (name.size())
+    {
+    case 6: if(name == "Member")   { return Account_Kind::Member;   } break;
+    case 7: if(name == "Manager")  { return Account_Kind::Manager;  } break;
+    case 8: if(name == "Provider") { return Account_Kind::Provider; } break;
+    }
+    return { };
+}
+
+constexpr std::string_view encode(Account_Status status)
+{
+    return (status == Account_Status::Suspended) ? "Suspended" : "Valid";
+}
+
+constexpr std::optional<Account_Status> decode_account_status(std::string_view name)
+{
+    switch (name.size())
+    {
+    case 5: if(name == "Valid")     { return Account_Status::Valid;     } break;
+    case 9: if(name == "Suspended") { return Account_Status::Suspended; } break;
+    }
+    return { };
+}
+
+namespace detail
+{
+
+constexpr std::string_view US_states[] =
+{ "AL", "AK", "AZ", "AR", "CA", "CO", "CT", "DE", "FL", "GA"
+, "HI", "ID", "IL", "IN", "IA", "KS", "KY", "LA", "ME", "MD"
+, "MA", "MI", "MN", "MS", "MO", "MT", "NE", "NV", "NH", "NJ"
+, "NM", "NY", "NC", "ND", "OH", "OK", "OR", "PA", "RI", "SC"
+, "SD", "TN", "TX", "UT", "VT", "VA", "WA", "WV", "WI", "WY" };
+
+// A two letter code is a perfect hash into 26 * 26 slots
+constexpr unsigned state_slot(std::string_view code)
+{
+    return (code[0] - 'A') * 26 + (code[1] - 'A');
+}
+
+using State_Bitmap = std::array<uint64_t, (26 * 26 + 63) / 64>;
+
+constexpr State_Bitmap build_state_bitmap()
+{
+    State_Bitmap bitmap {};
+    for(std::string_view code : US_states)
+    {
+        unsigned slot = state_slot(code);
+        bitmap[slot / 64] |= uint64_t(1) << (slot % 64);
+    }
+    return bitmap;
+}
+
+constexpr State_Bitmap state_bitmap = build_state_bitmap();
+
+} // namespace detail
+
+// The whole string must be digits, with no sign, padding, or trailing characters
+template <typename Number>
+Result<Number> decode_number(std::string_view digits)
+{
+    Number number {};
+    auto [end, err] = std::from_chars(digits.data(), digits.data() + digits.size(), number);
+
+    if(digits.empty() || digits[0] == '-' || err != std::errc() || end != digits.data() + digits.size())
+    {
+        return Error_Code::Malformed_Number;
+    }
+    return number;
+}
+
+inline Result<unsigned> decode_id(std::string_view digits)
+{
+    return decode_number<unsigned>(digits);
+}
+
+// Expects an upper case, two letter code
+constexpr bool is_us_state(std::string_view code)
+{
+    if(code.size() != 2 || code[0] < 'A' || code[0] > 'Z' || code[1] < 'A' || code[1] > 'Z')
+    {
+        return false;
+    }
+    unsigned slot = detail::state_slot(code);
+    return (detail::state_bitmap[slot / 64] >> (slot % 64)) & 1;
+}
+
+// Packs a valid state code into a number below 26 * 26, so it fits in ten bits
+constexpr uint16_t encode_state(std::string_view code)
+{
+    return static_cast<uint16_t>(detail::state_slot(code));
+}
+
+inline std::string decode_state(uint16_t slot)
+{
+    return { static_cast<char>('A' + slot / 26), static_cast<char>('A' + slot % 26) };
+}
+
+static_assert(decode_account_kind(encode(Account_Kind::Manager))  == Account_Kind::Manager);
+static_assert(decode_account_kind(encode(Account_Kind::Member))   == Account_Kind::Member);
+static_assert(decode_account_kind(encode(Account_Kind::Provider)) == Account_Kind::Provider);
+static_assert(decode_account_status(encode(Account_Status::Suspended)) == Account_Status::Suspended);
+static_assert(is_us_state("OR") && !is_us_state("ZZ"));
+
+} // namespace Codecs
+
+#endif // CHOCAN_CODECS_HPP
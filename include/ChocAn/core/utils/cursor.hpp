@@ -0,0 +1,121 @@
+/*
+
+File: cursor.hpp
+
+Brief: Cursor yields the rows of a query one at a time, fetching them from the
+       source a batch at a time. Only the current batch is held in memory.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_CURSOR_HPP
+#define CHOCAN_CURSOR_HPP
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <optional>
+#include <functional>
+
+template <typename T>
+class Cursor
+{
+public:
+
+    using Batch = std::vector<T>;
+
+    // Returns up to limit rows following the last row of the previous batch,
+    // an empty batch ends the query
+    using Fetch = std::function<Batch(size_t limit)>;
+
+    static constexpr size_t default_batch_size = 256;
+
+    explicit Cursor(Fetch fetch, size_t batch_size = default_batch_size)
+        : fetch      ( std::move(fetch) )
+        , batch_size ( (batch_size) ? batch_size : 1 )
+        { }
+
+    // A cursor over no rows
+    static Cursor empty() { return Cursor([](size_t) { return Batch(); }); }
+
+    // Returns the next row, empty once every row has been returned
+    std::optional<T> next()
+    {
+        if(position == batch.size())
+        {
+            if(exhausted) { return { }; }
+
+            batch     = fetch(batch_size);
+            position  = 0;
+            exhausted = batch.empty();
+
+            if(exhausted) { return { }; }
+        }
+        return std::move(batch[position++]);
+    }
+
+    // Takes effect on the next fetch
+    void set_batch_size(size_t size) { batch_size = (size) ? size : 1; }
+
+    // Collects every remaining row
+    Batch drain()
+    {
+        Batch rows;
+        while(auto row = next()) { rows.push_back(std::move(*row)); }
+        return rows;
+    }
+
+    // Single pass input iterator, so a cursor can be consumed with range-for
+    class iterator
+    {
+    public:
+
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        iterator() = default;
+
+        explicit iterator(Cursor* cursor)
+            : cursor ( cursor )
+            , row    ( cursor->next() )
+            { }
+
+        reference operator*()  const { return *row; }
+        pointer   operator->() const { return &*row; }
+
+        iterator& operator++() { row = cursor->next(); return *this; }
+
+        // Iterators are only equal once both are past the end
+        bool operator==(const iterator& rhs) const { return !row && !rhs.row; }
+        bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+
+        Cursor*          cursor = nullptr;
+        std::optional<T> row;
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end()   { return iterator(); }
+
+private:
+
+    Fetch  fetch;
+    size_t batch_size;
+    Batch  batch;
+    size_t position  = 0;
+    bool   exhausted = false;
+};
+
+#endif // CHOCAN_CURSOR_HPP
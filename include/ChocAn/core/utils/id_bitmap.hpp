@@ -0,0 +1,72 @@
+/*
+
+File: id_bitmap.hpp
+
+Brief: ID Bitmap is a compressed set of 32 bit IDs in the style of a roaring
+       bitmap. IDs are grouped by their high 16 bits, each group holds the low
+       16 bits in a sorted array while it is sparse and in a 65536 bit bitmap
+       once it is dense. Membership is a binary search over at most 65536
+       groups followed by a binary search or a single bit test.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_ID_BITMAP_HPP
+#define CHOCAN_ID_BITMAP_HPP
+
+#include <vector>
+#include <cstdint>
+
+class ID_Bitmap
+{
+public:
+
+    // Past this many IDs a group's bitmap is smaller than its array
+    static constexpr size_t array_limit = 4096;
+
+    // Returns false if the ID was already in the set
+    bool insert(uint32_t id);
+
+    // Returns false if the ID was not in the set
+    bool erase(uint32_t id);
+
+    bool contains(uint32_t id) const;
+
+    size_t size() const { return count; }
+    bool  empty() const { return count == 0; }
+
+    void clear();
+
+    // Bytes held by the groups, excluding unused capacity
+    size_t bytes() const;
+
+private:
+
+    struct Container
+    {
+        uint16_t              key;
+        uint32_t              cardinality = 0;
+        std::vector<uint16_t> array = { }; // Sorted low bits while sparse
+        std::vector<uint64_t> bits  = { }; // 1024 words once dense, array is then empty
+
+        bool dense() const { return !bits.empty(); }
+
+        bool contains(uint16_t low) const;
+        bool insert(uint16_t low);
+        bool erase(uint16_t low);
+    };
+
+    // Sorted by key
+    std::vector<Container> containers;
+    size_t                 count = 0;
+};
+
+#endif // CHOCAN_ID_BITMAP_HPP
@@ -0,0 +1,118 @@
+/*
+
+File: latency_histogram.hpp
+
+Brief: Latency Histogram records durations into log-linear buckets so that
+       percentiles can be estimated in constant memory.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_LATENCY_HISTOGRAM_HPP
+#define CHOCAN_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+#include <algorithm>
+
+class Latency_Histogram
+{
+public:
+
+    using Duration = std::chrono::microseconds;
+
+    // Values below 'linear_limit' get their own bucket, above that each power
+    // of two is split into 'sub_buckets' buckets (~12% relative error)
+    static constexpr unsigned linear_limit = 16;
+    static constexpr unsigned sub_buckets  = 8;
+    static constexpr unsigned sub_bits     = 3;
+    static constexpr unsigned max_exponent = 40;
+    static constexpr unsigned num_buckets  = linear_limit + (max_exponent - 4) * sub_buckets;
+
+    void record(Duration elapsed)
+    {
+        unsigned long long value = (elapsed.count() < 0) ? 0 : elapsed.count();
+
+        ++buckets[bucket_of(value)];
+        ++_count;
+        _total += value;
+        _min = (_count == 1) ? value : std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    void merge(const Latency_Histogram& other)
+    {
+        if(other._count == 0) { return; }
+
+        for(unsigned i = 0; i < num_buckets; ++i) { buckets[i] += other.buckets[i]; }
+
+        _min = (_count == 0) ? other._min : std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        _count += other._count;
+        _total += other._total;
+    }
+
+    // Returns the upper bound of the bucket holding the p-th percentile, p in [0, 100]
+    Duration percentile(double p) const
+    {
+        if(_count == 0) { return Duration(0); }
+
+        unsigned long long rank = static_cast<unsigned long long>((p / 100.0) * _count + 0.5);
+        rank = std::max(1ULL, std::min(rank, _count));
+
+        unsigned long long seen = 0;
+        for(unsigned i = 0; i < num_buckets; ++i)
+        {
+            seen += buckets[i];
+            if(seen >= rank) { return Duration(std::min(upper_bound_of(i), _max)); }
+        }
+        return Duration(_max);
+    }
+
+    unsigned long long count() const { return _count; }
+
+    Duration total() const { return Duration(_total); }
+    Duration min()   const { return Duration(_min);   }
+    Duration max()   const { return Duration(_max);   }
+    Duration mean()  const { return Duration((_count) ? _total / _count : 0); }
+
+private:
+
+    static unsigned bucket_of(unsigned long long value)
+    {
+        if(value < linear_limit) { return static_cast<unsigned>(value); }
+
+        unsigned exponent = 63 - __builtin_clzll(value);
+        if(exponent >= max_exponent) { return num_buckets - 1; }
+
+        unsigned sub = static_cast<unsigned>(value >> (exponent - sub_bits)) & (sub_buckets - 1);
+        return linear_limit + (exponent - 4) * sub_buckets + sub;
+    }
+
+    static unsigned long long upper_bound_of(unsigned bucket)
+    {
+        if(bucket < linear_limit) { return bucket; }
+
+        unsigned exponent = (bucket - linear_limit) / sub_buckets + 4;
+        unsigned sub      = (bucket - linear_limit) % sub_buckets;
+
+        return (1ULL << exponent) + ((sub + 1ULL) << (exponent - sub_bits)) - 1;
+    }
+
+    std::array<unsigned long long, num_buckets> buckets {};
+
+    unsigned long long _count = 0;
+    unsigned long long _total = 0;
+    unsigned long long _min   = 0;
+    unsigned long long _max   = 0;
+};
+
+#endif // CHOCAN_LATENCY_HISTOGRAM_HPP
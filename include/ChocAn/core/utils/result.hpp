@@ -0,0 +1,89 @@
+/*
+
+File: result.hpp
+
+Brief: Result holds either a value or the error code explaining why there is no
+       value. Lookups and parsers on the hot path return a Result rather than
+       throwing, so a mistyped ID or a malformed row is just a branch.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_RESULT_HPP
+#define CHOCAN_RESULT_HPP
+
+#include <cassert>
+#include <utility>
+#include <variant>
+#include <optional>
+#include <type_traits>
+
+enum class Error_Code
+{
+    Malformed_Number, // Input is not a whole number in range of its type
+    Not_Found,        // No record has the ID
+    Wrong_Type,       // The record exists but is not of the requested type
+    Malformed_Row     // A stored row is missing or has unparsable fields
+};
+
+constexpr const char* to_string(Error_Code code)
+{
+    switch (code)
+    {
+    case Error_Code::Malformed_Number : return "Malformed number";
+    case Error_Code::Not_Found        : return "Not found";
+    case Error_Code::Wrong_Type       : return "Wrong type";
+    case Error_Code::Malformed_Row    : return "Malformed row";
+    }
+    return "";
+}
+
+template <typename T, typename E = Error_Code>
+class Result
+{
+public:
+
+    static_assert(!std::is_same_v<T, E>, "Result value and error types must differ");
+
+    Result(T value) : data ( std::in_place_index<0>, std::move(value) ) { }
+    Result(E error) : data ( std::in_place_index<1>, std::move(error) ) { }
+
+    bool has_value() const { return data.index() == 0; }
+    explicit operator bool() const { return has_value(); }
+
+    // The result must hold a value
+    T& value() &             { assert(has_value()); return *std::get_if<0>(&data); }
+    const T& value() const & { assert(has_value()); return *std::get_if<0>(&data); }
+    T&& value() &&           { assert(has_value()); return std::move(*std::get_if<0>(&data)); }
+
+    T& operator*() & { return value(); }
+    const T& operator*() const & { return value(); }
+    T* operator->() { return &value(); }
+    const T* operator->() const { return &value(); }
+
+    // The result must hold an error
+    E error() const { assert(!has_value()); return *std::get_if<1>(&data); }
+
+    T value_or(T fallback) const & { return (has_value()) ? value() : std::move(fallback); }
+
+    // Drops the error for callers that only care whether there is a value
+    std::optional<T> to_optional() &&
+    {
+        if(has_value()) { return std::move(*std::get_if<0>(&data)); }
+        return { };
+    }
+
+private:
+
+    std::variant<T, E> data;
+};
+
+#endif // CHOCAN_RESULT_HPP
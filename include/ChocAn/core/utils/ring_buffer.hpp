@@ -0,0 +1,75 @@
+/*
+
+File: ring_buffer.hpp
+
+Brief: Ring Buffer is a fixed capacity LIFO history. Pushing onto a full buffer
+       overwrites the oldest element, so memory use never grows.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_RING_BUFFER_HPP
+#define CHOCAN_RING_BUFFER_HPP
+
+#include <array>
+#include <utility>
+#include <optional>
+#include <initializer_list>
+#include <cstddef>
+
+template <typename T, std::size_t Capacity>
+class Ring_Buffer
+{
+public:
+
+    static_assert(Capacity > 0, "Ring_Buffer capacity must be non-zero");
+
+    Ring_Buffer() = default;
+
+    Ring_Buffer(std::initializer_list<T> items)
+    {
+        for(const T& item : items) { push(item); }
+    }
+
+    // Overwrites the oldest element when full
+    void push(T item)
+    {
+        head = (head + 1) % Capacity;
+        buffer[head].emplace(std::move(item));
+        if(count < Capacity) { ++count; }
+    }
+
+    // Moves the newest element out, the buffer must not be empty
+    T pop()
+    {
+        T item = std::move(*buffer[head]);
+        buffer[head].reset();
+        head = (head + Capacity - 1) % Capacity;
+        --count;
+        return item;
+    }
+
+    T& top() { return *buffer[head]; }
+    const T& top() const { return *buffer[head]; }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+
+    // Slots are constructed in place, so T need not be default constructible or assignable
+    std::array<std::optional<T>, Capacity> buffer {};
+    std::size_t head  = Capacity - 1;
+    std::size_t count = 0;
+};
+
+#endif // CHOCAN_RING_BUFFER_HPP
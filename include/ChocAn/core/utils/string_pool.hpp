@@ -0,0 +1,91 @@
+/*
+
+File: string_pool.hpp
+
+Brief: String Pool stores each distinct string once and hands out a 32 bit handle
+       for it. Records that repeat the same cities and street names hold handles
+       instead of their own copies.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_STRING_POOL_HPP
+#define CHOCAN_STRING_POOL_HPP
+
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+class String_Pool
+{
+public:
+
+    using Handle = uint32_t;
+
+    String_Pool() = default;
+
+    // The index refers into the strings it was built over, so a copy rebuilds its own
+    String_Pool(const String_Pool& other)
+        : strings ( other.strings )
+        { reindex(); }
+
+    String_Pool& operator=(const String_Pool& other)
+    {
+        if(this != &other)
+        {
+            strings = other.strings;
+            reindex();
+        }
+        return *this;
+    }
+
+    // Moving a deque hands over its blocks, so the views stay valid
+    String_Pool(String_Pool&&) = default;
+    String_Pool& operator=(String_Pool&&) = default;
+
+    // Returns the handle of the pooled copy of str, adding one if there is none.
+    // Strings are never removed, a handle stays valid for the life of the pool
+    Handle intern(std::string_view str)
+    {
+        auto found = index.find(str);
+        if(found != index.end()) { return found->second; }
+
+        Handle handle = static_cast<Handle>(strings.size());
+        strings.emplace_back(str);
+        index.emplace(strings.back(), handle);
+
+        return handle;
+    }
+
+    // The handle must have come from this pool
+    const std::string& at(Handle handle) const { return strings[handle]; }
+
+    size_t size() const { return strings.size(); }
+
+private:
+
+    void reindex()
+    {
+        index.clear();
+        for(size_t i = 0; i < strings.size(); ++i)
+        {
+            index.emplace(strings[i], static_cast<Handle>(i));
+        }
+    }
+
+    // Deque elements never move as it grows, so the index can key on views of them
+    std::deque<std::string>                      strings;
+    std::unordered_map<std::string_view, Handle> index;
+};
+
+#endif // CHOCAN_STRING_POOL_HPP
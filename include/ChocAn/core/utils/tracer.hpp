@@ -0,0 +1,96 @@
+/*
+
+File: tracer.hpp
+
+Brief: Tracer records timed spans of application activity and exports them in
+       the Chrome trace event format (chrome://tracing, Perfetto).
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_TRACER_HPP
+#define CHOCAN_TRACER_HPP
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Tracer
+{
+public:
+
+    using Clock      = std::chrono::steady_clock;
+    using Tracer_Ptr = std::shared_ptr<Tracer>;
+
+    struct Event
+    {
+        std::string name;
+        std::string category;
+        long long   start;    // microseconds since the tracer was created
+        long long   duration; // microseconds
+        unsigned    thread;
+    };
+
+    // Span records an event spanning its lifetime, a null tracer is a no-op
+    class Span
+    {
+    public:
+
+        Span(Tracer* tracer, std::string name, const char* category)
+            : tracer   ( tracer )
+            , name     ( (tracer) ? std::move(name) : std::string() )
+            , category ( category )
+            , start    ( (tracer) ? Clock::now() : Clock::time_point() )
+            { }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        ~Span()
+        {
+            if(tracer) { tracer->record(std::move(name), category, start, Clock::now()); }
+        }
+
+    private:
+
+        Tracer*           tracer;
+        std::string       name;
+        const char*       category;
+        Clock::time_point start;
+    };
+
+    Tracer() : epoch(Clock::now()) {}
+
+    void record(std::string name, const char* category, Clock::time_point start, Clock::time_point end);
+
+    std::vector<Event> events() const;
+
+    // Serializes all recorded events as a Chrome trace event JSON document
+    std::string chrome_trace() const;
+
+private:
+
+    unsigned thread_index(std::thread::id id);
+
+    static std::string json_escape(const std::string& str);
+
+    const Clock::time_point epoch;
+
+    mutable std::mutex lock;
+    std::vector<Event> _events;
+    std::map<std::thread::id, unsigned> threads;
+};
+
+#endif // CHOCAN_TRACER_HPP
@@ -18,8 +18,12 @@ https://github.com/AlexanderJDupree/ChocAn
 #ifndef CHOCAN_TRANSACTION_BUILDER_HPP
 #define CHOCAN_TRANSACTION_BUILDER_HPP
 
+#include <map>
+#include <string>
+#include <vector>
 #include <optional>
 #include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/service_catalog.hpp>
 #include <ChocAn/core/entities/service.hpp>
 #include <ChocAn/core/entities/account.hpp>
 #include <ChocAn/core/entities/datetime.hpp>
@@ -36,6 +40,7 @@ public:
     struct Set_Service       {};
 
     using Database_Ptr = Data_Gateway::Database_Ptr;
+    using Form         = std::map<std::string, std::string>;
     using Builder_State = std::variant< Set_Service_Date
                                       , Set_Provider_Acct
                                       , Set_Member_Acct
@@ -62,10 +67,28 @@ public:
 
     const std::optional<chocan_user_exception>& get_last_error() const;
 
+    // Most services offered when a service name is ambiguous
+    static constexpr size_t max_service_matches = 10;
+
+    // Fields of a claim entered at once, in the order a fast entry line lists them
+    static const std::vector<std::string> claim_fields;
+
+    static constexpr char fast_entry_delimiter = '|';
+
+    // Sets every field of claim_fields from the form. All fields are checked and
+    // those that fail are reported together in one error, the others are kept.
+    // Prompting resumes at the first field still unset
+    void set_fields(const Form& form);
+
+    // Splits "<member ID>|<MM-DD-YYYY>|<service>|<comments>" into the claim fields.
+    // Comments are optional and may themselves contain the delimiter
+    void set_fast_entry(const std::string& line);
+
     void set_member_acct_field   (const std::string& input);
     void set_provider_acct_field (const std::string& input);
     void set_provider_acct_field (const Account& account);
     void set_service_date_field  (const std::string& input);
+    // Accepts a service code, or a full, partial, or misspelled service name
     void set_service_field       (const std::string& input);
     void set_comments_field      (const std::string& input);
 
@@ -0,0 +1,66 @@
+/*
+
+File: account_record.hpp
+
+Brief: Account Record is the compact form Memory_DB keeps its roster in. Names,
+       cities, and street names are handles into a shared String_Pool, the
+       state, type, and status are packed into bits, and the record rebuilds
+       the full Account on demand.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_ACCOUNT_RECORD_HPP
+#define CHOCAN_ACCOUNT_RECORD_HPP
+
+#include <cstdint>
+#include <ChocAn/core/utils/string_pool.hpp>
+#include <ChocAn/core/entities/account.hpp>
+
+class Account_Record
+{
+public:
+
+    // Interns the account's strings into the pool
+    Account_Record(const Account& account, String_Pool& pool);
+
+    // The pool must be the one the record was packed with
+    Account unpack(const String_Pool& pool, const Key<Data_Gateway>& key) const;
+
+    unsigned id() const { return _id; }
+
+    Codecs::Account_Kind kind() const { return static_cast<Codecs::Account_Kind>(_kind); }
+
+    // Only members carry a status, every other account reads as Valid
+    Account_Status status() const { return static_cast<Account_Status>(_status); }
+
+private:
+
+    uint32_t _id;
+    String_Pool::Handle _first;
+    String_Pool::Handle _last;
+
+    // A street of "<number> <name>" keeps the number here and interns only the
+    // name, which many accounts share. Otherwise the number is 0 and the whole
+    // street is interned
+    uint32_t            _house_number;
+    String_Pool::Handle _street;
+    String_Pool::Handle _city;
+    uint32_t            _zip;
+
+    uint16_t _state  : 10;
+    uint16_t _kind   : 2;
+    uint16_t _status : 1;
+};
+
+static_assert(sizeof(Account_Record) <= 32, "Account records must stay compact");
+
+#endif // CHOCAN_ACCOUNT_RECORD_HPP
@@ -0,0 +1,92 @@
+/*
+
+File: claim_writer.hpp
+
+Brief: Claim Writer commits claims on a dedicated thread. Claims submitted by
+       concurrent sessions within a short window are inserted in a single
+       SQLite transaction, so they share one commit instead of each waiting
+       on the file lock for their own.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_CLAIM_WRITER_HPP
+#define CHOCAN_CLAIM_WRITER_HPP
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <condition_variable>
+#include <ChocAn/core/entities/transaction.hpp>
+
+class SQLite_DB;
+
+class Claim_Writer
+{
+public:
+
+    using Clock      = std::chrono::steady_clock;
+    using Duration   = std::chrono::microseconds;
+    using Writer_Ptr = std::shared_ptr<Claim_Writer>;
+
+    struct Stats
+    {
+        unsigned long long claims  = 0;
+        unsigned long long commits = 0;
+        size_t             largest = 0; // Most claims in one commit
+    };
+
+    // A group is committed once 'window' has passed since its first claim arrived, or
+    // once it holds 'max_group' claims. The writer owns db's connection from here on
+    explicit Claim_Writer( std::shared_ptr<SQLite_DB> db
+                         , Duration window    = std::chrono::milliseconds(2)
+                         , size_t   max_group = 64 );
+
+    Claim_Writer(const Claim_Writer&) = delete;
+    Claim_Writer& operator=(const Claim_Writer&) = delete;
+
+    // Commits every claim already submitted before returning
+    ~Claim_Writer();
+
+    // Resolves to the claim's transaction number once committed, 0 if it failed
+    std::future<unsigned> submit(const Transaction& claim);
+
+    Stats stats() const;
+
+private:
+
+    struct Pending
+    {
+        Transaction            claim;
+        std::promise<unsigned> id;
+        Clock::time_point      submitted;
+    };
+
+    void run();
+
+    std::shared_ptr<SQLite_DB> db;
+    Duration                   window;
+    size_t                     max_group;
+
+    mutable std::mutex      lock;
+    std::condition_variable arrived;
+    std::deque<Pending>     queue;
+    Stats                   totals;
+    bool                    stopping = false;
+
+    // Started last, once every member it reads is constructed
+    std::thread writer;
+};
+
+#endif // CHOCAN_CLAIM_WRITER_HPP
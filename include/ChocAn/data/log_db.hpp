@@ -0,0 +1,143 @@
+/*
+
+File: log_db.hpp
+
+Brief: Log DB is a log structured Data_Gateway. Every write is appended to a
+       checksummed segment log and applied to an in memory index, which is
+       rebuilt by replaying the log on startup.
+
+       Accounts and services live in an account log that is compacted into a
+       snapshot once superseded records outnumber live ones. Transactions are
+       write once and live in a separate append only claim log.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_LOG_DB_HPP
+#define CHOCAN_LOG_DB_HPP
+
+#include <string>
+#include <ChocAn/data/memory_db.hpp>
+
+class Log_DB : public Memory_DB
+{
+public:
+
+    enum class Sync_Policy
+    {
+        Always, // fdatasync after every record
+        Batch,  // fdatasync every batch_size records, and on flush, a crash may lose the unsynced batch
+        Never   // leave it to the OS
+    };
+
+    // Opens, or creates, the log in directory and replays it
+    explicit Log_DB(const std::string& directory, Sync_Policy sync = Sync_Policy::Batch);
+
+    Log_DB(const Log_DB&) = delete;
+    Log_DB& operator=(const Log_DB&) = delete;
+
+    ~Log_DB();
+
+    bool update_account(const Account& account) override;
+
+    unsigned create_account(const Account& account) override;
+
+    bool delete_account(const unsigned ID) override;
+
+    unsigned add_transaction(const Transaction& transaction) override;
+
+    bool add_service(const Service& service) override;
+
+    // Seeded records are written as one batch with a single sync at the end, whatever the policy
+    void import(Data_Gateway& source) override;
+
+    // Rewrites the account log as a snapshot of the live accounts and services
+    bool compact();
+
+    // Syncs any records written since the last sync
+    bool flush();
+
+    // Account log records that have been superseded since the last compaction
+    size_t dead_records() const { return dead; }
+
+    static constexpr size_t segment_size         = 8 << 20;
+    static constexpr size_t batch_size           = 256;
+    static constexpr size_t compaction_threshold = 1024;
+
+private:
+
+    class Segment_Log
+    {
+    public:
+
+        Segment_Log(const std::string& directory, const std::string& name);
+
+        Segment_Log(const Segment_Log&) = delete;
+        Segment_Log& operator=(const Segment_Log&) = delete;
+
+        ~Segment_Log();
+
+        // Calls apply for every intact record, starting at the latest snapshot
+        template <typename Apply>
+        void replay(Apply apply);
+
+        // A record that fails to write or sync is truncated away, so replay never applies it
+        bool append(Record_Type type, const std::string& payload, Sync_Policy sync);
+
+        // Appends between the two are held in memory, then written with one write and one sync
+        void begin_batch();
+        bool commit_batch();
+
+        // Writes framed records into a new segment that replaces every existing segment
+        bool rewrite(const std::string& records);
+
+        bool sync();
+
+    private:
+
+        std::string segment_path(unsigned number) const;
+
+        std::vector<unsigned> segment_numbers() const;
+
+        bool open_segment(unsigned number);
+
+        // Writes count framed records, truncating them away if the write or sync fails
+        bool write(const std::string& records, size_t count, Sync_Policy sync);
+
+        std::string directory;
+        std::string name;
+
+        int      fd      = -1;
+        unsigned active  = 0;
+        size_t   size    = 0;
+        size_t   pending = 0;
+
+        bool        batching = false;
+        std::string batch;
+        size_t      batched  = 0;
+    };
+
+    void apply(Record_Type type, const std::string& payload);
+
+    // Appends to log under the sync policy, with a span when tracing
+    bool append(Segment_Log& log, Record_Type type, const std::string& payload);
+
+    // Compacts the account log once superseded records outnumber live ones
+    void compact_if_needed();
+
+    Sync_Policy sync;
+    size_t      dead = 0;
+
+    Segment_Log account_log;
+    Segment_Log claim_log;
+};
+
+#endif // CHOCAN_LOG_DB_HPP
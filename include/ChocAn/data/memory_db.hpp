@@ -0,0 +1,192 @@
+/*
+
+File: memory_db.hpp
+
+Brief: Memory DB is an in memory Data_Gateway engine. Accounts and services are
+       hash indexed, transactions are stored once and indexed by service date
+       both globally and per account so that range queries are O(log n + k).
+       Accounts are held as compact records over one pool of interned strings
+       and rebuilt when they are read.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_MEMORY_DB_HPP
+#define CHOCAN_MEMORY_DB_HPP
+
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/data/record_codec.hpp>
+#include <ChocAn/data/account_record.hpp>
+#include <ChocAn/core/entities/account.hpp>
+#include <ChocAn/core/entities/service.hpp>
+#include <ChocAn/core/entities/transaction.hpp>
+
+class Memory_DB : public Data_Gateway
+{
+public:
+
+    using Account_Index = std::unordered_map<unsigned, Account_Record>;
+    using Service_Index = std::unordered_map<unsigned, Service>;
+    using ID_Set        = std::set<unsigned>;
+
+    // Lower cased word of an account's name or address -> accounts containing it
+    using Token_Index   = std::map<std::string, ID_Set>;
+
+    // Service date (unix timestamp) -> slot in the transaction store
+    using Date_Index    = std::multimap<int, size_t>;
+    using Posting_Lists = std::unordered_map<unsigned, Date_Index>;
+
+    Memory_DB() = default;
+
+    // Copies every account, service, and transaction from another gateway
+    explicit Memory_DB(Data_Gateway& source);
+
+    virtual ~Memory_DB() = default;
+
+    // Adds every account, service, and transaction from another gateway
+    virtual void import(Data_Gateway& source);
+
+    // Writes every account, service, and transaction to a binary snapshot file
+    bool save_snapshot(const std::string& path) const;
+
+    // Replaces the contents with a snapshot file. Returns false, leaving the contents
+    // unchanged, if the file is missing, corrupt, or holds a malformed record
+    bool load_snapshot(const std::string& path);
+
+    // Changes whenever a snapshot replaces the contents, observers are not told of them
+    unsigned long external_version() override { return snapshots_loaded; }
+
+    bool update_account(const Account& account) override;
+
+    unsigned create_account(const Account& account) override;
+
+    bool delete_account(const unsigned ID) override;
+
+    // Returns the sequential transaction number, 0 if the transaction was already filed
+    unsigned add_transaction(const Transaction& transaction) override;
+
+    // Inserts or replaces a service in the directory
+    virtual bool add_service(const Service& service);
+
+    std::optional<Account> get_account(const unsigned ID) override;
+    std::optional<Account> get_account(const std::string& ID) override;
+
+    std::optional<Account> get_member_account(const unsigned ID) override;
+    std::optional<Account> get_member_account(const std::string& ID) override;
+
+    std::optional<Account> get_provider_account(const unsigned ID) override;
+    std::optional<Account> get_provider_account(const std::string& ID) override;
+
+    std::optional<Account> get_manager_account(const unsigned ID) override;
+    std::optional<Account> get_manager_account(const std::string& ID) override;
+
+    std::optional<Service> lookup_service(const unsigned code) override;
+    std::optional<Service> lookup_service(const std::string& code) override;
+
+    Service_Directory service_directory() override;
+
+    unsigned long services_version() override { return service_version; }
+
+    bool id_exists(const unsigned ID) const override;
+
+    Transactions get_transactions(DateTime start, DateTime end, Account acct) override;
+    Transactions get_transactions(DateTime start, DateTime end) override;
+
+    Accounts get_member_accounts() override;
+    Accounts get_provider_accounts() override;
+    Accounts get_manager_accounts() override;
+
+    Account_Cursor scan_member_accounts()   override;
+    Account_Cursor scan_provider_accounts() override;
+    Account_Cursor scan_manager_accounts()  override;
+
+    Transaction_Cursor scan_transactions(DateTime start, DateTime end, Account acct) override;
+    Transaction_Cursor scan_transactions(DateTime start, DateTime end) override;
+
+    Transaction_Summaries transaction_summaries(DateTime start, DateTime end) override;
+
+    std::optional<Account_Header> account_header(const unsigned ID) override;
+
+    // Merges the type indexes, so headers come out in ID order
+    Header_Cursor scan_account_headers() override;
+
+    // Whole word matches rank above prefix matches, ties are ordered by ID
+    Accounts search_accounts(const std::string& query, size_t limit) override;
+
+    size_t account_count()     const { return accounts.size();     }
+    size_t transaction_count() const { return transactions.size(); }
+
+protected:
+
+    using Record_Type = Record_Codec::Record_Type;
+
+    // Applies a snapshot or log record to the indexes, returns true if it replaced or
+    // removed an existing entry. Throws chocan_db_exception if the record is malformed
+    bool apply_record(Record_Type type, const std::string& payload);
+
+    ID_Set& type_index(Codecs::Account_Kind kind);
+
+    // The account must exist
+    Account account_at(const unsigned ID) const;
+
+    // Adds or removes the account's words from the token index
+    void index_tokens(const Account& account, bool insert);
+
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    std::optional<Account> lookup_typed(const unsigned ID, Codecs::Account_Kind kind) const;
+
+    Accounts collect(const ID_Set& ids) const;
+
+    Transactions collect(const Date_Index& index, DateTime start, DateTime end) const;
+
+    // Cursors keep the last key returned and seek past it, so they never hold index iterators
+    Account_Cursor scan(const ID_Set& ids) const;
+
+    Transaction_Cursor scan(const Date_Index& index, DateTime start, DateTime end) const;
+
+    static std::optional<unsigned> parse_key(const std::string& key);
+
+    // Identifies a filed claim, the same claim filed twice is a duplicate
+    static std::string transaction_key(const Transaction& transaction);
+
+    bool is_filed(const Transaction& transaction) const;
+
+    // Claims stay filed when their provider or member is deleted, but like SQLite_DB's joins
+    // reads leave them out until an account of the right type has the ID again
+    bool has_accounts(const Transaction& transaction) const;
+
+    // Swaps the stored accounts, services, and transactions, and their indexes
+    void swap_contents(Memory_DB& other);
+
+    Account_Index accounts;
+    String_Pool   strings;
+    ID_Set        members;
+    ID_Set        providers;
+    ID_Set        managers;
+    Token_Index   tokens;
+
+    Service_Index services;
+    unsigned long service_version = 0;
+
+    // Transactions are append only, indexes refer to their slot in the store
+    std::vector<Transaction>        transactions;
+    std::unordered_set<std::string> filed;
+    Date_Index                      by_service_date;
+    Posting_Lists                   by_account;
+
+    unsigned long snapshots_loaded = 0;
+};
+
+#endif // CHOCAN_MEMORY_DB_HPP
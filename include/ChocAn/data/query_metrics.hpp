@@ -0,0 +1,97 @@
+/*
+
+File: query_metrics.hpp
+
+Brief: Query Metrics aggregates call counts, rows returned and latency for
+       each query shape executed by a database connector, and keeps a
+       bounded log of statements that exceeded the slow query threshold.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_QUERY_METRICS_HPP
+#define CHOCAN_QUERY_METRICS_HPP
+
+#include <map>
+#include <deque>
+#include <string>
+#include <chrono>
+#include <ChocAn/core/utils/latency_histogram.hpp>
+
+class Query_Metrics
+{
+public:
+
+    using Clock    = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    struct Query_Stats
+    {
+        unsigned long calls  = 0;
+        unsigned long rows   = 0;
+        unsigned long errors = 0;
+        Latency_Histogram latency;
+    };
+
+    struct Slow_Query
+    {
+        std::string sql;
+        Duration    elapsed;
+        std::string query_plan;
+    };
+
+    // Key is the normalized query shape
+    using Stats_Table = std::map<std::string, Query_Stats>;
+    using Slow_Log    = std::deque<Slow_Query>;
+
+    // Key is the table a malformed row was skipped from
+    using Malformed_Table = std::map<std::string, unsigned long>;
+
+    static constexpr size_t max_slow_log_size = 64;
+    static constexpr size_t max_shape_length  = 160;
+
+    Query_Metrics(Duration slow_threshold = std::chrono::milliseconds(100))
+        : threshold(slow_threshold) {}
+
+    // Replaces literals with '?' and collapses whitespace, so that queries
+    // differing only in their parameters share the same shape
+    static std::string normalize(const std::string& sql);
+
+    void record(const std::string& sql, Duration elapsed, unsigned long rows, bool ok);
+
+    bool is_slow(Duration elapsed) const { return elapsed >= threshold; }
+    void log_slow_query(const std::string& sql, Duration elapsed, const std::string& plan);
+
+    // Rows that could not be decoded are skipped by readers and counted here
+    void record_malformed(const std::string& table) { ++malformed[table]; }
+
+    void set_slow_threshold(Duration slow_threshold) { threshold = slow_threshold; }
+    Duration slow_threshold() const { return threshold; }
+
+    const Stats_Table& stats() const { return table; }
+    const Slow_Log& slow_log() const { return slow_queries; }
+    const Malformed_Table& malformed_rows() const { return malformed; }
+
+    // Formatted table of per shape stats followed by the slow query log
+    std::string report() const;
+
+    void reset();
+
+private:
+
+    Duration    threshold;
+    Stats_Table table;
+    Slow_Log    slow_queries;
+
+    Malformed_Table malformed;
+};
+
+#endif // CHOCAN_QUERY_METRICS_HPP
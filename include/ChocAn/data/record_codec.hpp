@@ -0,0 +1,100 @@
+/*
+
+File: record_codec.hpp
+
+Brief: Record Codec frames and encodes the binary records shared by the Log_DB
+       segment logs and Memory_DB snapshots. A record is its payload length,
+       the crc32 of its type and payload, its type, then the payload.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#ifndef CHOCAN_RECORD_CODEC_HPP
+#define CHOCAN_RECORD_CODEC_HPP
+
+#include <map>
+#include <string>
+#include <cstdint>
+#include <ChocAn/core/data_gateway.hpp>
+
+class Record_Codec
+{
+public:
+
+    using Data_Table = std::map<std::string, std::string>;
+
+    enum class Record_Type : uint8_t
+    {
+        Snapshot       = 1,
+        Account_Put    = 2,
+        Account_Delete = 3,
+        Service_Put    = 4,
+        Transaction    = 5
+    };
+
+    static constexpr size_t   header_size     = 9;
+    static constexpr uint32_t max_record_size = 1 << 20;
+
+    static std::string frame(Record_Type type, const std::string& payload);
+
+    // Calls apply for each intact record in data, returns the offset just past the last one
+    template <typename Apply>
+    static size_t parse(const std::string& data, Apply apply);
+
+    static std::string encode(const Data_Table& table);
+
+    // A payload with a truncated field is Malformed_Row
+    static Result<Data_Table> decode(const std::string& payload);
+
+    static std::string encode(const Account& account);
+    static std::string encode(const Service& service);
+
+    // Transactions carry their accounts and service so they never depend on other records
+    static std::string encode(const Transaction& transaction);
+
+    static Result<Account>     decode_account(const std::string& payload, const Key<Data_Gateway>& key);
+    static Result<Service>     decode_service(const std::string& payload, const Key<Data_Gateway>& key);
+    static Result<Transaction> decode_transaction(const std::string& payload, const Key<Data_Gateway>& key);
+
+    static uint32_t crc32(const char* data, size_t length, uint32_t crc = 0);
+
+    // Replaces path with data via a synced temporary file, readers see the old or new file, never a mix
+    static bool write_atomic(const std::string& path, const std::string& data);
+
+    // Directory entries must be synced for a new or renamed file to survive a crash
+    static void sync_directory(const std::string& directory);
+
+    static uint32_t get_u32(const std::string& buffer, size_t offset);
+    static void     put_u32(std::string& buffer, uint32_t value);
+};
+
+template <typename Apply>
+size_t Record_Codec::parse(const std::string& data, Apply apply)
+{
+    size_t offset = 0;
+    while(offset + header_size <= data.length())
+    {
+        uint32_t length = get_u32(data, offset);
+        uint32_t crc    = get_u32(data, offset + 4);
+
+        if(length > max_record_size || offset + header_size + length > data.length()
+           || crc32(data.data() + offset + 8, length + 1) != crc)
+        {
+            break;
+        }
+        apply(static_cast<Record_Type>(data[offset + 8]), data.substr(offset + header_size, length));
+
+        offset += header_size + length;
+    }
+    return offset;
+}
+
+#endif // CHOCAN_RECORD_CODEC_HPP
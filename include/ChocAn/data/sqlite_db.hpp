@@ -17,9 +17,13 @@ https://github.com/AlexanderJDupree/ChocAn
 #ifndef CHOCAN_SQLITE_DB_HPP
 #define CHOCAN_SQLITE_DB_HPP
 
+#include <deque>
 #include <sqlite3.h>
 #include <functional>
 #include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/utils/tracer.hpp>
+#include <ChocAn/data/claim_writer.hpp>
+#include <ChocAn/data/query_metrics.hpp>
 
 class SQLite_DB  : public Data_Gateway
 {
@@ -28,6 +32,22 @@ public:
     using SQL_Row      = std::map<std::string, std::string>;
     using SQL_Callback = int (*) (void*,int,char**,char**);
 
+    // How long a statement waits on a lock held by another connection before failing
+    static constexpr int busy_timeout_ms = 5000;
+
+    // Kept in PRAGMA user_version. Version 1 keys transactions by transaction_id
+    static constexpr int schema_version = 1;
+
+    // One month of transactions, stored in its own table or its own database file
+    struct Partition
+    {
+        int         month;      // yyyymm
+        long        first_date; // Holds service dates in [first_date, end_date), UTC month bounds
+        long        end_date;
+        bool        sealed;     // Rewritten in key order and read only
+        std::string file;       // Archive file, empty while the partition lives in this database
+    };
+
     SQLite_DB(const char* db_name);
 
     SQLite_DB(const char* db_name, const char* schema_file);
@@ -36,6 +56,19 @@ public:
 
     bool load_schema(const char* schema_file);
 
+    // Brings a database made by an older schema up to schema_version, run on every open.
+    // Databases without a schema are left unstamped
+    bool migrate();
+
+    // Replaces this database's contents with a page copy of an on disk database image
+    bool restore_from(const char* db_file);
+
+    // Writes a page copy of this database to db_file, safe while the database is in use
+    bool backup_to(const char* db_file);
+
+    // True if the file starts with the SQLite database header
+    static bool is_database_image(const char* file);
+
     unsigned create_account(const Account& account) override;
 
     // Will overwrite previous row data with account info
@@ -45,8 +78,40 @@ public:
 
     bool id_exists(const unsigned ID) const override;
 
+    // Goes through the claim writer when one is set, blocking until its group commits
     unsigned add_transaction(const Transaction& transaction) override;
 
+    // Inserts every transaction in one SQLite transaction, a failed insert leaves the rest
+    // in place. Returns each transaction's number, 0 for those that failed
+    std::vector<unsigned> add_transactions(const Transactions& transactions);
+
+    // Shares a group commit writer between connections, the writer must have its own connection
+    void set_claim_writer(Claim_Writer::Writer_Ptr writer) { claim_writer = writer; }
+
+    // Moves the rows of the transactions table into monthly partitions listed in the
+    // transaction_partitions catalog. From then on the transactions table is only the template
+    // partitions are created from: inserts go to the partition of their service date, and
+    // range queries read only the partitions that overlap the range. Transaction IDs come from
+    // the transaction_keys table, so they stay unique across partitions. Databases are only
+    // partitioned when this is called, loading a schema leaves them unpartitioned
+    bool partition_transactions();
+
+    // The catalog in month order, empty if the transactions are not partitioned
+    std::vector<Partition> transaction_partitions();
+
+    // Seals every partition of a month ending before the cutoff, returns how many were sealed.
+    // Claims dated in a sealed month are rejected
+    unsigned seal_partitions(DateTime before);
+
+    // Moves a sealed partition into a new database file, attached only while a query reads it
+    bool archive_partition(int month, const std::string& file);
+
+    // Drops an archived partition from the catalog, its file is left as the archive
+    bool detach_partition(int month);
+
+    // Catalogs an archive made by archive_partition again
+    bool attach_partition(const std::string& file);
+
     // DB retrieval may fail, wrap in Maybe type
     std::optional<Account> get_account(const unsigned ID) override;
     std::optional<Account> get_account(const std::string& ID) override;
@@ -68,10 +133,52 @@ public:
 
     Accounts get_member_accounts() override;
     Accounts get_provider_accounts() override;
+    Accounts get_manager_accounts() override;
     Accounts get_all_accounts(const std::string& type);
 
+    Account_Cursor scan_member_accounts()   override;
+    Account_Cursor scan_provider_accounts() override;
+    Account_Cursor scan_manager_accounts()  override;
+
+    // Pages by chocan_id, type "*" scans every account
+    Account_Cursor scan_accounts(const std::string& type);
+
+    Transaction_Cursor scan_transactions(DateTime start, DateTime end, Account acct) override;
+    Transaction_Cursor scan_transactions(DateTime start, DateTime end) override;
+
+    // Reads ids, dates, and the service cost, joined from services. The account checks
+    // build_transaction makes are EXISTS probes on the accounts key
+    Transaction_Summaries transaction_summaries(DateTime start, DateTime end) override;
+
+    std::optional<Account_Header> account_header(const unsigned ID) override;
+
+    // Pages by chocan_id
+    Header_Cursor scan_account_headers() override;
+
+    // Backed by the accounts_fts FTS5 index, results are ordered by bm25 rank
+    Accounts search_accounts(const std::string& query, size_t limit) override;
+
     Service_Directory service_directory() override;
 
+    // Maintained by triggers on the services table, 0 if the database predates the catalog_version table
+    unsigned long services_version() override;
+
+    // Connections to the same file share an ID, each in memory database is its own store
+    std::string store_id() const override;
+
+    // SQLite's data version, bumped by commits from any other connection to the file
+    unsigned long external_version() override;
+
+    // Maintained by triggers on the accounts table, 0 if the database predates the accounts_version table
+    unsigned long accounts_version() override;
+
+    // Per query shape stats and slow query log for this connection
+    Query_Metrics& query_metrics() { return metrics; }
+    const Query_Metrics& query_metrics() const { return metrics; }
+
+    // Error message reported by sqlite3 for the last failed statement
+    const std::string& last_error() const { return last_err; }
+
 private:
 
 
@@ -80,15 +187,65 @@ private:
 
     std::vector<SQL_Row> get_transaction_data(DateTime start, DateTime end, unsigned id = 0, std::string type = "*");
 
+    // Pages by (service_date, transaction_id), transaction_id is the primary key
+    Transaction_Cursor scan_transaction_data(DateTime start, DateTime end, unsigned id = 0, std::string type = "*");
+
+    // Rows with missing, unparsable, or dangling fields are Malformed_Row
+    Result<Transaction> build_transaction(const SQL_Row& row);
+
+    std::vector<SQL_Row> select_rows(const std::string& sql);
+
     bool id_exists(const unsigned ID, std::string& table);
 
     std::string sqlquote(const std::string& str) const;
 
     bool execute_statement(const std::string& sql, SQL_Callback, void* data=nullptr);
 
+    // Prepares and steps a single statement, handing each row to read. Columns keep their
+    // stored types, so integers are read without the text round trip of a callback
+    bool step_rows(const std::string& sql, const std::function<void(sqlite3_stmt*)>& read);
+
+    void record_query(const std::string& sql, Query_Metrics::Duration elapsed, unsigned long rows, bool ok);
+
+    unsigned insert_transaction(const Transaction& transaction);
+
+    std::string explain_query_plan(const std::string& sql);
+
+    bool copy_database(sqlite3* source, sqlite3* destination);
+
+    // Partitions are detected lazily, another connection may partition the database
+    bool is_partitioned();
+
+    std::vector<Partition> read_partitions(const std::string& where);
+
+    // Catalog entry for the month holding the date, computed by SQLite so bounds are UTC months
+    std::optional<Partition> month_of(long date);
+
+    // Finds, or creates, the partition a transaction dated on service_date goes to
+    std::optional<Partition> partition_for(long service_date);
+
+    // Table a partition is read from, attaching its archive file if need be
+    std::optional<std::string> partition_source(const Partition& partition);
+
+    // Partitions overlapping [start, end] in month order
+    std::vector<Partition> overlapping_partitions(DateTime start, DateTime end);
+
+    // CREATE statements for a table and index shaped like the transactions table
+    std::string partition_ddl(const std::string& schema, const std::string& table);
+
+    bool make_read_only(const std::string& schema, const std::string& table);
+
+    void release_archive(int month);
 
     sqlite3* db;
     char* err_msg = 0;
+    std::string last_err;
+    Query_Metrics metrics;
+    Claim_Writer::Writer_Ptr claim_writer;
+
+    bool                      partitioned = false;
+    std::map<long, Partition> partitions;  // Keyed by first_date, a cache of the catalog
+    std::deque<int>           attached;    // Months of archives attached, oldest first
     SQL_Callback no_callback = [](void*, int, char**, char**) -> int { return 0; };
 };
 
@@ -19,20 +19,35 @@ https://github.com/AlexanderJDupree/ChocAn
 #define CHOCAN_VIEW_RESOURCE_LOADER_HPP
 
 #include <map>
+#include <array>
+#include <memory>
+#include <functional>
+#include <memory_resource>
 #include <ChocAn/app/application_state.hpp>
 #include <ChocAn/core/entities/account_report.hpp>
 
 struct Resource_Loader
 {
-    using Resource_Table    = std::map<std::string, std::string>;
+    using Resource_Table    = std::pmr::map<std::string, std::string>;
     using Provider_Activity = Summary_Report::Provider_Activity;
 
+    // Holds the nodes of every table built in one interaction, tables that outgrow it spill to the heap
+    static constexpr size_t arena_size = 8 * 1024;
+
+    Resource_Loader()
+        : state(nullptr)
+        { }
+
     Resource_Loader(const Application_State& state)
         : state(&state)
         { update(); }
 
+    // Rebuilds the table for the current state, reusing the arena of the last table
     void update();
 
+    // Points the loader at a new state and builds its table
+    void load(const Application_State& state);
+
     Resource_Table operator()(const Exit&);
     Resource_Table operator()(const Login& login);
     Resource_Table operator()(const View_Account&);
@@ -53,20 +68,52 @@ struct Resource_Loader
     std::string center(unsigned num, unsigned width = 20) const;
     std::string center(const std::string& str, unsigned width = 20) const;
 
+    // Row renderers append cells in place instead of concatenating temporaries
+    void append_cell(std::string& row, const std::string& str, unsigned width = 20) const;
+    void append_cell(std::string& row, unsigned num, unsigned width = 20) const;
+
     /* Special Rendering Methods */
     std::string render_user_error(const std::optional<chocan_user_exception>& maybe_err) const;
     std::string render_builder_prompt(Account_Builder::Build_State state) const;
 
-    std::string render_provider_activity(const Provider_Activity& activity) const;
-    std::string render_account_activity(const Provider_Report& report) const;
-    std::string render_account_activity(const Member_Report& report) const;
+    // Activity renderers format only the rows in [first, last)
+    std::string render_provider_activity(const Provider_Activity& activity, size_t first, size_t last) const;
+    std::string render_account_activity(const Provider_Report& report, size_t first, size_t last) const;
+    std::string render_account_activity(const Member_Report& report, size_t first, size_t last) const;
+
+    std::string render_account_totals(const Provider_Report& report) const;
+
+    std::string render_page(const View_Report& state) const;
 
-    std::string render_directory(const Data_Gateway::Service_Directory& directory) const;
+    std::string render_directory(const Service_Catalog& catalog) const;
+
+    std::string render_matches(const std::vector<Account>& matches) const;
 
     std::string render_summary(const Summary_Report& summary) const;
 
+    // Returns the table last built from source if source is unchanged, otherwise builds it
+    Resource_Table memoize(const std::shared_ptr<const void>& source, const std::function<Resource_Table()>& build);
+
+    // An empty table in the arena, or one holding the entries of a serialized entity
+    Resource_Table make_table();
+    Resource_Table make_table(std::map<std::string, std::string>&& entries);
+
     const Application_State* state;
-    Resource_Table table;
+
+    // Every table is gone by the time the next one is built, so a monotonic arena reset
+    // per interaction replaces a malloc and free for every node. Declared before the
+    // tables so it outlives them
+    std::array<std::byte, arena_size>   arena_buffer;
+    std::pmr::monotonic_buffer_resource arena { arena_buffer.data(), arena_buffer.size() };
+
+    Resource_Table table { &arena };
+
+    // Tables built from immutable shared data (reports, the service catalog) are reused
+    // while the state holds the same handle. A weak handle compares by owner, so a new
+    // object allocated at a freed address is never mistaken for the cached one
+    // memoized tables outlive the interaction, so they are kept on the heap
+    std::weak_ptr<const void> memo_source;
+    Resource_Table            memo_table;
 };
 
 #endif // CHOCAN_VIEW_RESOURCE_LOADER_HPP
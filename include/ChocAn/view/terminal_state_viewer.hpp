@@ -24,6 +24,7 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <iostream>
 #include <functional>
 #include <ChocAn/app/state_viewer.hpp>
+#include <ChocAn/core/utils/tracer.hpp>
 #include <ChocAn/view/resource_loader.hpp>
 
 class Terminal_State_Viewer : public State_Viewer
@@ -32,6 +33,7 @@ public:
 
     using Command_Table  = std::map<std::string, std::function<void()>>;
     using Resource_Table = std::map<std::string, std::function<std::string()>>;
+    using View_Cache     = std::map<std::string, std::string>;
 
     Terminal_State_Viewer( bool compact_output          = false
                          , std::ostream& out_stream     = std::cout
@@ -45,13 +47,21 @@ public:
     // Stores state, looks up state in view table, renders view
     void render_state(const Application_State& state, Callback handler = [](){}) override;
 
+    // Records spans for resource table building and view rendering
+    void set_tracer(Tracer::Tracer_Ptr tracer) { this->tracer = tracer; }
+
 private:
 
+    // Renders the view for the loaded resource table
+    void render();
+
     void render_view(const std::string& view_name);
 
+    // Views are read from disk once per viewer, null if the view file cannot be opened
+    const std::string* load_view(const std::string& view_name);
+
     std::string read_resource(const std::string& resource_name);
 
-    std::string read_command(std::ifstream& file);
     void execute_command(const std::string& command);
 
     void clear_screen() const;
@@ -63,7 +73,9 @@ private:
     std::ostream&       out_stream;
     Command_Table       command_table;
     Resource_Loader     resources;
+    View_Cache          views;
     Callback            event_callback;
+    Tracer::Tracer_Ptr  tracer;
     bool                compact_output;
 };
 
@@ -70,7 +70,7 @@ project "ChocAn-Core"
 
 project "ChocAn-Data"
     kind "SharedLib"
-    links { "ChocAn-Core", "sqlite3" }
+    links { "ChocAn-Core", "sqlite3", "pthread" }
     language "C++"
     targetdir "lib/%{cfg.buildcfg}/"
     targetname "ChocAn-Data"
@@ -83,7 +83,7 @@ project "ChocAn-Data"
 
 project "ChocAn-App"
     kind "SharedLib"
-    links "ChocAn-Core"
+    links { "ChocAn-Core", "pthread" }
     language "C++"
     targetdir "lib/%{cfg.buildcfg}/"
     targetname "ChocAn-App"
@@ -120,10 +120,23 @@ project "ChocAn-Exe"
     files (source .. "main.cpp")
     includedirs{ include, "third_party" }
 
+project "ChocAn-Load"
+    kind "ConsoleApp"
+    language "C++"
+    links { "ChocAn-Core", "ChocAn-Data", "ChocAn-App", "ChocAn-View", "pthread" }
+    targetdir "bin/%{cfg.buildcfg}/"
+    targetname  "ChocAn_load_%{cfg.buildcfg}"
+
+    local source = "src/"
+    local include = "include/"
+
+    files (source .. "load_generator.cpp")
+    includedirs{ include, "third_party" }
+
 project "Tests"
     kind "ConsoleApp"
     language "C++"
-    links { "ChocAn-Core", "ChocAn-Data", "ChocAn-App", "ChocAn-View" }
+    links { "ChocAn-Core", "ChocAn-Data", "ChocAn-App", "ChocAn-View", "sqlite3" }
     targetdir "bin/tests/"
     targetname "%{cfg.buildcfg}_tests"
 
@@ -0,0 +1,301 @@
+/*
+
+File: session_scheduler.cpp
+
+Brief: Session Scheduler implementation. Fibers are ucontext stacks, each worker
+       keeps a queue of its runnable fibers and switches into them in turn.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <stdexcept>
+#include <new>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <unordered_map>
+#include <ChocAn/app/session_scheduler.hpp>
+
+namespace
+{
+
+// Mapped rather than allocated, so the page below the stack can be a guard page. A session
+// that overflows its stack faults on the guard page instead of writing over the heap
+class Fiber_Stack
+{
+public:
+
+    explicit Fiber_Stack(size_t size)
+        : page   ( static_cast<size_t>(::sysconf(_SC_PAGESIZE)) )
+        , usable ( (size + page - 1) / page * page )
+    {
+        void* mapped = ::mmap(nullptr, page + usable, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if(mapped == MAP_FAILED) { throw std::bad_alloc(); }
+
+        // Stacks grow down, the guard is the lowest page of the mapping
+        if(::mprotect(mapped, page, PROT_NONE) != 0)
+        {
+            ::munmap(mapped, page + usable);
+            throw std::bad_alloc();
+        }
+        base = static_cast<char*>(mapped);
+    }
+
+    ~Fiber_Stack() { ::munmap(base, page + usable); }
+
+    Fiber_Stack(const Fiber_Stack&) = delete;
+    Fiber_Stack& operator=(const Fiber_Stack&) = delete;
+
+    char*  bottom() const { return base + page; }
+    size_t size()   const { return usable; }
+
+private:
+
+    size_t page;
+    size_t usable;
+    char*  base = nullptr;
+};
+
+} // namespace
+
+class Session_Scheduler::Fiber
+{
+public:
+
+    explicit Fiber(size_t stack_size) : stack(stack_size) { }
+
+    ucontext_t         context;
+    Fiber_Stack        stack;
+    Session            session;
+    Worker*            worker    = nullptr;
+    bool               started   = false;
+    bool               cancelled = false;
+    bool               done      = false;
+    std::exception_ptr error;
+};
+
+struct Session_Scheduler::Worker
+{
+    std::mutex              lock;
+    std::condition_variable ready;
+    std::deque<Fiber*>      runnable;
+    bool                    stopping = false;
+
+    // Fibers started on this worker, freed once they return
+    std::unordered_map<Fiber*, std::unique_ptr<Fiber>> fibers;
+
+    // Where a fiber switches back to when it parks, yields, or returns
+    ucontext_t  context;
+    std::thread thread;
+};
+
+namespace
+{
+
+thread_local Session_Scheduler::Fiber* running = nullptr;
+
+} // namespace
+
+Session_Scheduler::Session_Scheduler(unsigned threads, size_t stack_size)
+    : stack_size ( stack_size )
+{
+    for(unsigned i = 0; i < std::max(threads, 1u); ++i)
+    {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for(std::unique_ptr<Worker>& worker : workers)
+    {
+        worker->thread = std::thread(&Session_Scheduler::worker_loop, this, std::ref(*worker));
+    }
+}
+
+Session_Scheduler::~Session_Scheduler()
+{
+    for(std::unique_ptr<Worker>& worker : workers)
+    {
+        {
+            std::lock_guard<std::mutex> guard(worker->lock);
+            worker->stopping = true;
+        }
+        worker->ready.notify_one();
+    }
+    // Each worker cancels its own sessions before it returns
+    for(std::unique_ptr<Worker>& worker : workers) { worker->thread.join(); }
+}
+
+void Session_Scheduler::spawn(Session session)
+{
+    // Anonymous mappings are only committed as the session touches their pages
+    auto fiber = std::make_unique<Fiber>(stack_size);
+    fiber->session = std::move(session);
+
+    Worker* worker = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        worker = workers[next_worker++ % workers.size()].get();
+        ++live;
+    }
+    fiber->worker = worker;
+
+    getcontext(&fiber->context);
+    fiber->context.uc_stack.ss_sp   = fiber->stack.bottom();
+    fiber->context.uc_stack.ss_size = fiber->stack.size();
+    fiber->context.uc_link          = &worker->context;
+    makecontext(&fiber->context, &Session_Scheduler::run_fiber, 0);
+
+    {
+        std::lock_guard<std::mutex> guard(worker->lock);
+        Fiber* handle = fiber.get();
+        worker->fibers.emplace(handle, std::move(fiber));
+        worker->runnable.push_back(handle);
+    }
+    worker->ready.notify_one();
+}
+
+void Session_Scheduler::wait()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    idle.wait(guard, [this] { return live == 0; });
+
+    if(first_error) { std::rethrow_exception(std::exchange(first_error, nullptr)); }
+}
+
+size_t Session_Scheduler::sessions() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return live;
+}
+
+Session_Scheduler::Fiber* Session_Scheduler::current()
+{
+    return running;
+}
+
+void Session_Scheduler::park()
+{
+    if(!running) { throw std::logic_error("Session_Scheduler: park called outside of a session"); }
+
+    switch_out();
+}
+
+void Session_Scheduler::yield()
+{
+    Fiber* fiber = running;
+    if(!fiber) { return; }
+
+    // The worker is running this fiber, so it cannot be resumed before it switches out
+    {
+        std::lock_guard<std::mutex> guard(fiber->worker->lock);
+        fiber->worker->runnable.push_back(fiber);
+    }
+    switch_out();
+}
+
+void Session_Scheduler::wake(Fiber* fiber)
+{
+    {
+        std::lock_guard<std::mutex> guard(fiber->worker->lock);
+        fiber->worker->runnable.push_back(fiber);
+    }
+    fiber->worker->ready.notify_one();
+}
+
+void Session_Scheduler::run_fiber()
+{
+    Fiber* fiber = running;
+    fiber->started = true;
+    try
+    {
+        fiber->session();
+    }
+    catch(...)
+    {
+        fiber->error = std::current_exception();
+    }
+    // Returning resumes the worker through uc_link
+    fiber->done = true;
+}
+
+void Session_Scheduler::switch_out()
+{
+    Fiber* fiber = running;
+
+    // A cancelled session that catches Cancelled and waits again gets it again, it never switches out
+    if(!fiber->cancelled) { swapcontext(&fiber->context, &fiber->worker->context); }
+    if(fiber->cancelled)  { throw Cancelled(); }
+}
+
+void Session_Scheduler::worker_loop(Worker& worker)
+{
+    while(true)
+    {
+        Fiber* fiber = nullptr;
+        {
+            std::unique_lock<std::mutex> guard(worker.lock);
+            worker.ready.wait(guard, [&] { return worker.stopping || !worker.runnable.empty(); });
+
+            if(worker.stopping) { break; }
+
+            fiber = worker.runnable.front();
+            worker.runnable.pop_front();
+        }
+
+        running = fiber;
+        swapcontext(&worker.context, &fiber->context);
+        running = nullptr;
+
+        if(fiber->done)
+        {
+            std::exception_ptr error = std::move(fiber->error);
+            {
+                std::lock_guard<std::mutex> guard(worker.lock);
+                worker.fibers.erase(fiber);
+            }
+            finish(error);
+        }
+    }
+    cancel_sessions(worker);
+}
+
+void Session_Scheduler::cancel_sessions(Worker& worker)
+{
+    std::vector<Fiber*> started;
+    {
+        std::lock_guard<std::mutex> guard(worker.lock);
+        for(auto& entry : worker.fibers)
+        {
+            if(entry.first->started && !entry.first->done) { started.push_back(entry.first); }
+        }
+    }
+
+    // Resumed here, on the worker it started on, its park or yield throws Cancelled so the
+    // stack unwinds with the same thread local state it ran with
+    for(Fiber* fiber : started)
+    {
+        fiber->cancelled = true;
+
+        running = fiber;
+        swapcontext(&worker.context, &fiber->context);
+        running = nullptr;
+    }
+}
+
+void Session_Scheduler::finish(std::exception_ptr error)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    if(error && !first_error) { first_error = error; }
+    if(--live == 0) { idle.notify_all(); }
+}
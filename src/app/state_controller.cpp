@@ -16,11 +16,15 @@ https://github.com/AlexanderJDupree/ChocAn
  
 */
 
+#include <cctype>
+#include <algorithm>
 #include <functional>
 #include <ChocAn/app/application_state.hpp>
+#include <ChocAn/core/utils/codecs.hpp>
 #include <ChocAn/core/utils/parsers.hpp>
 #include <ChocAn/app/state_controller.hpp>
 #include <ChocAn/core/utils/overloaded.hpp>
+#include <ChocAn/app/traced_input_controller.hpp>
 #include <ChocAn/core/utils/transaction_builder.hpp>
 
 State_Controller::State_Controller( ChocAn_Ptr        chocan
@@ -42,13 +46,53 @@ State_Controller::State_Controller( ChocAn_Ptr        chocan
 
 State_Controller& State_Controller::interact()
 {
-    // TODO implement runtime as ring buffer Or dequeue
     Application_State current_state = pop_runtime();
+
+    Tracer::Span span(tracer.get(), (tracer) ? state_name(current_state) : "", "state");
+
+    if(recorder) { recorder->enter_state(state_name(current_state)); }
+
     runtime.push(std::visit(*this, current_state));
 
     return *this;
 }
 
+void State_Controller::enable_tracing(Tracer::Tracer_Ptr tracer)
+{
+    if(!tracer || this->tracer) { return; }
+
+    this->tracer = tracer;
+    input_controller = std::make_shared<Traced_Input_Controller>(input_controller, tracer);
+}
+
+void State_Controller::enable_recording(std::ostream& session)
+{
+    if(recorder) { return; }
+
+    recorder = std::make_shared<Session_Recorder>(input_controller, session);
+    input_controller = recorder;
+}
+
+const char* State_Controller::state_name(const Application_State& state)
+{
+    return std::visit( overloaded {
+        [](const Exit&)                   { return "Exit"; },
+        [](const Login&)                  { return "Login"; },
+        [](const View_Report&)            { return "View_Report"; },
+        [](const Manager_Menu&)           { return "Manager_Menu"; },
+        [](const Find_Account&)           { return "Find_Account"; },
+        [](const View_Account&)           { return "View_Account"; },
+        [](const Provider_Menu&)          { return "Provider_Menu"; },
+        [](const Create_Account&)         { return "Create_Account"; },
+        [](const Update_Account&)         { return "Update_Account"; },
+        [](const Delete_Account&)         { return "Delete_Account"; },
+        [](const Generate_Report&)        { return "Generate_Report"; },
+        [](const Add_Transaction&)        { return "Add_Transaction"; },
+        [](const Confirm_Transaction&)    { return "Confirm_Transaction"; },
+        [](const View_Service_Directory&) { return "View_Service_Directory"; }
+    }, state);
+}
+
 const Application_State& State_Controller::current_state() const
 {
     return runtime.top();
@@ -61,11 +105,10 @@ bool State_Controller::end_state() const
 
 Application_State State_Controller::pop_runtime()
 {
-    Application_State temp = runtime.top();
-
-    runtime.pop();
+    // History older than max_history states was dropped, there is nothing to return to
+    if(runtime.empty()) { return Exit(); }
 
-    return temp;
+    return runtime.pop();
 }
 
 Application_State State_Controller::operator()(Login& login)
@@ -105,42 +148,52 @@ Application_State State_Controller::operator()(Exit& exit)
     // logout is idempotent
     chocan->login_manager.logout();
 
-    return exit;
+    return std::move(exit);
 }
 
+namespace
+{
+
+template <size_t N>
+State_Controller::Transition find_transition(const State_Controller::Menu_Entry (&menu)[N], std::string_view input)
+{
+    auto entry = std::find_if(std::begin(menu), std::end(menu), [&](const State_Controller::Menu_Entry& entry)
+    {
+        return entry.first == input;
+    } );
+    return (entry == std::end(menu)) ? nullptr : entry->second;
+}
+
+} // namespace
+
 Application_State State_Controller::operator()(Provider_Menu& menu)
 {
     runtime.push(menu);
     state_viewer->render_state(menu) ;
 
-    const Transition_Table provider_menu
+    static constexpr Menu_Entry provider_menu[]
     {
-        { "exit", [&](){ return Exit();  } },
-        { "0"   , [&](){ chocan->login_manager.logout(); return Login(); } },
-        { "1"   , [&](){ 
-            return View_Account { chocan->db->get_account(chocan->login_manager.session_owner().id()).value() }; } },
-        { "2"   , [&](){ 
-            return Update_Account { chocan->login_manager.session_owner() 
-                                  , &chocan->account_builder.reset() }; } 
+        { "exit", [](State_Controller&) -> Application_State { return Exit();  } },
+        { "0"   , [](State_Controller& self) -> Application_State { self.chocan->login_manager.logout(); return Login(); } },
+        { "1"   , [](State_Controller& self) -> Application_State { 
+            return View_Account { self.chocan->db->get_account(self.chocan->login_manager.session_owner().id()).value() }; } },
+        { "2"   , [](State_Controller& self) -> Application_State { 
+            return Update_Account { self.chocan->login_manager.session_owner() 
+                                  , &self.chocan->account_builder.reset() }; } 
         },
-        { "3"   , [&](){ return Find_Account{ Find_Account::Next::Update_Account }; } },
-        { "4"   , [&](){ return Find_Account(); } },
-        { "5"   , [&](){ 
-            chocan->transaction_builder.reset();
-            chocan->transaction_builder.set_provider_acct_field(chocan->login_manager.session_owner());
-            return Add_Transaction{ &chocan->transaction_builder }; } 
+        { "3"   , [](State_Controller&) -> Application_State { return Find_Account{ Find_Account::Next::Update_Account }; } },
+        { "4"   , [](State_Controller&) -> Application_State { return Find_Account(); } },
+        { "5"   , [](State_Controller& self) -> Application_State { 
+            self.chocan->transaction_builder.reset();
+            self.chocan->transaction_builder.set_provider_acct_field(self.chocan->login_manager.session_owner());
+            return Add_Transaction{ &self.chocan->transaction_builder }; } 
         },
-        { "6"   , [&](){ return View_Service_Directory { chocan->db }; } }
+        { "6"   , [](State_Controller& self) -> Application_State { return View_Service_Directory { self.chocan->db->service_catalog() }; } }
     };
 
-    try
-    {
-        return provider_menu.at(input_controller->read_input())();
-    }
-    catch(const std::out_of_range& err)
-    {
-        return Provider_Menu {{ "Unrecognized Input" }};
-    }
+    Transition transition = find_transition(provider_menu, input_controller->read_input());
+
+    return (transition) ? transition(*this) : Provider_Menu {{ "Unrecognized Input" }};
 }
 
 Application_State State_Controller::operator()(Manager_Menu& menu)
@@ -148,28 +201,23 @@ Application_State State_Controller::operator()(Manager_Menu& menu)
     runtime.push(menu);
     state_viewer->render_state(menu) ;
 
-    const Transition_Table manager_menu
+    static constexpr Menu_Entry manager_menu[]
     {
-        { "exit", [&](){ return Exit();  } },
-        { "0"   , [&](){ chocan->login_manager.logout(); return Login(); } },
-        { "1"   , [&](){ return Find_Account(); } },
-        { "2"   , [&](){ return Create_Account{ 
-            &chocan->account_builder.initiate_new_build_process() }; } 
+        { "exit", [](State_Controller&) -> Application_State { return Exit();  } },
+        { "0"   , [](State_Controller& self) -> Application_State { self.chocan->login_manager.logout(); return Login(); } },
+        { "1"   , [](State_Controller&) -> Application_State { return Find_Account(); } },
+        { "2"   , [](State_Controller& self) -> Application_State { return Create_Account{ 
+            &self.chocan->account_builder.initiate_new_build_process() }; } 
         },
-        { "3"   , [&](){ return Find_Account { Find_Account::Next::Delete_Account }; }},
-        { "4"   , [&](){ return Generate_Report(); } },
-        { "5"   , [&](){ return Find_Account { Find_Account::Next::Gen_Provider_Report }; }},
-        { "6"   , [&](){ return Find_Account { Find_Account::Next::Gen_Member_Report }; }},
+        { "3"   , [](State_Controller&) -> Application_State { return Find_Account { Find_Account::Next::Delete_Account }; }},
+        { "4"   , [](State_Controller&) -> Application_State { return Generate_Report(); } },
+        { "5"   , [](State_Controller&) -> Application_State { return Find_Account { Find_Account::Next::Gen_Provider_Report }; }},
+        { "6"   , [](State_Controller&) -> Application_State { return Find_Account { Find_Account::Next::Gen_Member_Report }; }},
     };
 
-    try
-    {
-        return manager_menu.at(input_controller->read_input())();
-    }
-    catch(const std::out_of_range& err)
-    {
-        return Manager_Menu {{ "Unrecognized Input" }};
-    }
+    Transition transition = find_transition(manager_menu, input_controller->read_input());
+
+    return (transition) ? transition(*this) : Manager_Menu {{ "Unrecognized Input" }};
 }
 
 Application_State State_Controller::operator()(Add_Transaction& state)
@@ -182,7 +230,7 @@ Application_State State_Controller::operator()(Add_Transaction& state)
 
     if(input == "exit")   { return Exit(); }
     if(input == "cancel") { return Provider_Menu {{ "Transaction Request Cancelled!" }}; }
-    if(input == "help")   { runtime.push(state); return View_Service_Directory { chocan->db }; }
+    if(input == "help")   { runtime.push(std::move(state)); return View_Service_Directory { chocan->db->service_catalog() }; }
 
     chocan->transaction_builder.set_current_field(input);
 
@@ -238,7 +286,7 @@ Application_State State_Controller::operator()(Create_Account& state)
     
     state_viewer->render_state(state);
 
-    if(!state.builder->buildable()) { return state; }
+    if(!state.builder->buildable()) { return std::move(state); }
 
     Account temp_account = chocan->account_builder.build_new_account(chocan->db);
 
@@ -261,7 +309,7 @@ Application_State State_Controller::operator()(Create_Account& state)
 
     // User said no, restart account build
     state.builder->initiate_new_build_process();
-    return state;
+    return std::move(state);
 }
 
 Application_State State_Controller::operator()(View_Account& state)
@@ -301,18 +349,22 @@ Application_State State_Controller::operator()(Delete_Account& state)
 Application_State State_Controller::operator()(Find_Account& state)
 {
     using Get_Account_Function = std::function<std::optional<Account>(const std::string&)>;
+    using Account_Filter       = std::function<bool(const Account&)>;
 
     std::string err_msg;
+    Account_Filter accepts = [](const Account&) { return true; };
     auto get_account = [&]() -> Get_Account_Function {
 
         if(state.next == Find_Account::Next::Gen_Member_Report || std::holds_alternative<Provider>(chocan->login_manager.session_owner().type()))
         {
             err_msg = "Error, not a ChocAn Member ID: ";
+            accepts = [](const Account& account) { return std::holds_alternative<Member>(account.type()); };
             return [&](const std::string& id) { return chocan->db->get_member_account(id); };
         }
         else if(state.next == Find_Account::Next::Gen_Provider_Report)
         {
             err_msg = "Error, not a ChocAn Provider ID: ";
+            accepts = [](const Account& account) { return std::holds_alternative<Provider>(account.type()); };
             return [&](const std::string& id) { return chocan->db->get_provider_account(id); };
         }
         else
@@ -347,8 +399,22 @@ Application_State State_Controller::operator()(Find_Account& state)
         default: return View_Account { maybe_account.value() };
         }
     }
+
+    // Anything that is not an ID is searched for by name or address, the user then picks an ID
+    bool is_id = !input.empty() && std::all_of(input.begin(), input.end(), [](unsigned char c) { return std::isdigit(c); });
+    if(!is_id && !input.empty())
+    {
+        state.matches.clear();
+        for(Account& account : chocan->db->search_accounts(input, Find_Account::max_matches))
+        {
+            if(accepts(account)) { state.matches.push_back(std::move(account)); }
+        }
+        state.status = (state.matches.empty()) ? "No accounts match: " + input
+                                               : "Accounts matching: " + input;
+        return std::move(state);
+    }
     state.status = err_msg + input;
-    return state;
+    return std::move(state);
 }
 
 Application_State State_Controller::operator()(Generate_Report& state)
@@ -356,24 +422,19 @@ Application_State State_Controller::operator()(Generate_Report& state)
     // We have enough dates to generate a report
     if(state.date_range.size() == 2) 
     { 
+        const DateTime& start = state.date_range[0];
+        const DateTime& end   = state.date_range[1];
+
+        // Reports come from the reporter's cache, repeat views of a range share one report
         switch (state.type)
         {
         case Generate_Report::Report_Type::Member :
-            return View_Report { 
-                chocan->reporter.gen_member_report(state.date_range[0], state.date_range[1], state.account.value()) 
-            }; 
+            return View_Report { chocan->reporter.member_report(start, end, state.account.value()) };
         case Generate_Report::Report_Type::Provider :
-            return View_Report { 
-                chocan->reporter.gen_provider_report(state.date_range[0], state.date_range[1], state.account.value()) 
-            }; 
+            return View_Report { chocan->reporter.provider_report(start, end, state.account.value()) };
         default: // Summary Report
-            return View_Report { 
-                chocan->reporter.gen_summary_report(state.date_range[0], state.date_range[1]) 
-            }; 
+            return View_Report { chocan->reporter.summary_report(start, end) };
         }
-        return View_Report { 
-            chocan->reporter.gen_summary_report(state.date_range[0], state.date_range[1]) 
-        }; 
     }
 
     std::string input;
@@ -389,7 +450,7 @@ Application_State State_Controller::operator()(Generate_Report& state)
     if(input == "all") 
     {
         state.date_range = { DateTime(0), DateTime::get_current_datetime() };
-        return state;
+        return std::move(state);
     }
 
     try
@@ -400,14 +461,45 @@ Application_State State_Controller::operator()(Generate_Report& state)
     {
         state.error.emplace(err);
     }
-    return state;
+    return std::move(state);
 }
 
 Application_State State_Controller::operator()(View_Report& state)
 {
+    std::string input;
     state_viewer->render_state(state, [&](){
-        input_controller->read_input();
+        input = input_controller->read_input();
     }) ;
+
+    // Reports that fit on one page have no paging commands, any input leaves them
+    if(state.page_count() == 1) { return pop_runtime(); }
+
+    state.status.clear();
+
+    if(input == "next")
+    {
+        if(state.page + 1 < state.page_count()) { ++state.page; }
+        else { state.status = "Already on the last page"; }
+        return std::move(state);
+    }
+    if(input == "prev")
+    {
+        if(state.page > 0) { --state.page; }
+        else { state.status = "Already on the first page"; }
+        return std::move(state);
+    }
+    if(input.rfind("page", 0) == 0)
+    {
+        // The whole argument must be the page number, "page 2abc" is rejected like "page two"
+        size_t first = input.find_first_not_of(' ', 4);
+        size_t last  = input.find_last_not_of(' ');
+        Result<size_t> page = (first == std::string::npos) ? Error_Code::Malformed_Number
+                            : Codecs::decode_number<size_t>(std::string_view(input).substr(first, last - first + 1));
+
+        if(page && page.value() >= 1 && page.value() <= state.page_count()) { state.page = page.value() - 1; }
+        else { state.status = "Page must be between 1-" + std::to_string(state.page_count()); }
+        return std::move(state);
+    }
     return pop_runtime();
 }
 
@@ -445,7 +537,7 @@ Application_State State_Controller::operator()(Update_Account& state)
         {
             state.msg = "Unrecognized input";
         }
-        return state;
+        return std::move(state);
     }
     if(state.status == Update_Account::Status::Update_Field)
     {
@@ -483,5 +575,5 @@ Application_State State_Controller::operator()(Update_Account& state)
             return Provider_Menu {{ "Account Failed to update." }};
         }
     }
-    return state;
+    return std::move(state);
 }
@@ -0,0 +1,76 @@
+/*
+
+File: transition_metrics.cpp
+
+Brief: Transition Metrics implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <iomanip>
+#include <sstream>
+#include <ChocAn/app/transition_metrics.hpp>
+
+void Transition_Metrics::record(const std::string& from, const std::string& to, Duration elapsed)
+{
+    table[{ from, to }].record(elapsed);
+}
+
+void Transition_Metrics::merge(const Transition_Metrics& other)
+{
+    for(const auto& entry : other.table)
+    {
+        table[entry.first].merge(entry.second);
+    }
+}
+
+unsigned long long Transition_Metrics::count() const
+{
+    unsigned long long transitions = 0;
+    for(const auto& entry : table) { transitions += entry.second.count(); }
+    return transitions;
+}
+
+Latency_Histogram Transition_Metrics::from(const std::string& state) const
+{
+    Latency_Histogram histogram;
+    for(auto entry = table.lower_bound({ state, "" }); entry != table.end() && entry->first.first == state; ++entry)
+    {
+        histogram.merge(entry->second);
+    }
+    return histogram;
+}
+
+std::string Transition_Metrics::report() const
+{
+    std::stringstream stream;
+
+    stream << std::setw(8)  << "count"
+           << std::setw(12) << "mean(us)"
+           << std::setw(12) << "p50(us)"
+           << std::setw(12) << "p99(us)"
+           << std::setw(12) << "p99.9(us)"
+           << std::setw(12) << "max(us)"
+           << "  transition\n";
+
+    for(const auto& entry : table)
+    {
+        const Latency_Histogram& latency = entry.second;
+        stream << std::setw(8)  << latency.count()
+               << std::setw(12) << latency.mean().count()
+               << std::setw(12) << latency.percentile(50).count()
+               << std::setw(12) << latency.percentile(99).count()
+               << std::setw(12) << latency.percentile(99.9).count()
+               << std::setw(12) << latency.max().count()
+               << "  " << entry.first.first << " -> " << entry.first.second << '\n';
+    }
+    return stream.str();
+}
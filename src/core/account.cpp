@@ -15,10 +15,14 @@ https://github.com/AlexanderJDupree/ChocAn
  
 */
 
-#include <functional>
-#include <ChocAn/core/utils/overloaded.hpp>
+#include <ChocAn/core/utils/codecs.hpp>
 #include <ChocAn/core/entities/account.hpp>
 
+// Account kinds are encoded by their index in Account_Type
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(Codecs::Account_Kind::Manager),  Account::Account_Type>, Manager>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(Codecs::Account_Kind::Member),   Account::Account_Type>, Member>);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(Codecs::Account_Kind::Provider), Account::Account_Type>, Provider>);
+
 Account::Account(Name name, Address address, Account_Type type, const ID_Generator& id_gen)
     : _name    ( name    )
     , _address ( address )
@@ -40,32 +44,63 @@ Account::Account(const Data_Table& data, const Key<Data_Gateway>& )
                          , data.at("state")
                          , std::stoi(data.at("zip")) ) )
 {
-    std::map<std::string, std::function<Account::Account_Type()>> type_constructor
+    switch (Codecs::decode_account_kind(data.at("type")).value())
     {
-        { "Manager",  [&](){ return Manager();  } },
-        { "Provider", [&](){ return Provider(); } },
-        { "Member",   [&]()
-        { 
-            return Member(data.at("status") == "Suspended" ? Account_Status::Suspended 
-                                                           : Account_Status::Valid); 
-        } }
-    };
-
-    _type = type_constructor.at(data.at("type"))();
+    case Codecs::Account_Kind::Manager  : _type = Manager();  break;
+    case Codecs::Account_Kind::Provider : _type = Provider(); break;
+    case Codecs::Account_Kind::Member   :
+        _type = Member(Codecs::decode_account_status(data.at("status")).value_or(Account_Status::Valid));
+        break;
+    }
     _id   = std::stoi(data.at("chocan_id"));
 }
 
+Result<Account> Account::decode(const Data_Table& data, const Key<Data_Gateway>& key)
+{
+    for(const char* column : { "f_name", "l_name", "street", "city", "state", "zip", "chocan_id", "type" })
+    {
+        if(!data.count(column)) { return Error_Code::Malformed_Row; }
+    }
+    std::optional<Codecs::Account_Kind> kind = Codecs::decode_account_kind(data.at("type"));
+    Result<unsigned> zip = Codecs::decode_id(data.at("zip"));
+    Result<unsigned> id  = Codecs::decode_id(data.at("chocan_id"));
+    if(!kind || !zip || !id)
+    {
+        return Error_Code::Malformed_Row;
+    }
+
+    Account_Type type;
+    switch (*kind)
+    {
+    case Codecs::Account_Kind::Manager  : type = Manager();  break;
+    case Codecs::Account_Kind::Provider : type = Provider(); break;
+    case Codecs::Account_Kind::Member   :
+    {
+        auto status = data.find("status");
+        type = Member((status == data.end()) ? Account_Status::Valid
+                                             : Codecs::decode_account_status(status->second).value_or(Account_Status::Valid));
+        break;
+    }
+    }
+    try
+    {
+        return Account( Name(data.at("f_name"), data.at("l_name"))
+                      , Address(data.at("street"), data.at("city"), data.at("state"), zip.value())
+                      , type
+                      , id.value()
+                      , key );
+    }
+    catch(const chocan_user_exception&)
+    {
+        // Names and addresses over their length limits
+        return Error_Code::Malformed_Row;
+    }
+}
+
 Account::Data_Table Account::serialize() const
 {
-    std::string status = "Valid";
-    std::string type = std::visit( overloaded {
-        [&](const Manager&) -> std::string { return "Manager";  },
-        [&](const Provider&)-> std::string { return "Provider"; },
-        [&](const Member& m)-> std::string {
-            status = (m.status() == Account_Status::Valid) ? status : "Suspended";
-            return "Member";
-        }
-    }, _type);
+    auto kind = static_cast<Codecs::Account_Kind>(_type.index());
+    auto status = (kind == Codecs::Account_Kind::Member) ? std::get<Member>(_type).status() : Account_Status::Valid;
 
     return 
     {
@@ -76,8 +111,8 @@ Account::Data_Table Account::serialize() const
         { "state" , _address.state()  },
         { "chocan_id", std::to_string(_id) },
         { "zip"   , std::to_string(_address.zip()) },
-        { "type"  , type   },
-        { "status", status }
+        { "type"  , std::string(Codecs::encode(kind))   },
+        { "status", std::string(Codecs::encode(status)) }
     };
 }
 
@@ -262,9 +262,10 @@ void Account_Builder::deriveZip(const std::string &input)
 }
 Account::Account_Type Account_Builder::yield_account_type() const{
 
-    if(fields.type.value() == "Manager") return Manager();
-    
-    if(fields.type.value() == "Provider") return Provider();
-
-    return Member();
+    switch (Codecs::decode_account_kind(fields.type.value()).value_or(Codecs::Account_Kind::Member))
+    {
+    case Codecs::Account_Kind::Manager  : return Manager();
+    case Codecs::Account_Kind::Provider : return Provider();
+    default: return Member();
+    }
 }
@@ -49,6 +49,49 @@ unsigned Provider_Report::services_rendered() const
     return _transactions.size();
 }
 
+Provider_Summary::Provider_Summary(const Account& account, const Claims& claims)
+    : _account(account)
+    , _claims(claims)
+{
+    if(!std::holds_alternative<Provider>(account.type()))
+    {
+        throw std::logic_error("Can't compile provider reports for non-provider account");
+    }
+
+    for(const auto& claim : claims)
+    {
+        if (account.id() != claim.provider_id)
+        {
+            throw std::logic_error("Reporting Error: Unrelated transaction activity");
+        }
+    }
+}
+
+Provider_Summary::Provider_Summary(const Provider_Report& report)
+    : _account(report.account())
+{
+    _claims.reserve(report.transactions().size());
+    for(const auto& transaction : report.transactions())
+    {
+        _claims.push_back(Data_Gateway::summarize(transaction));
+    }
+}
+
+USD Provider_Summary::total_fee() const
+{
+    USD sum{ 0.0 };
+    for (const auto& claim : _claims)
+    {
+        sum += claim.cost;
+    }
+    return sum;
+}
+
+unsigned Provider_Summary::services_rendered() const
+{
+    return _claims.size();
+}
+
 unsigned Summary_Report::num_providers() const
 {
     return _activity.size();
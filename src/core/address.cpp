@@ -17,15 +17,9 @@ https://github.com/AlexanderJDupree/ChocAn
 */
 
 #include <ChocAn/core/entities/address.hpp>
+#include <ChocAn/core/utils/codecs.hpp>
 #include <ChocAn/core/utils/validators.hpp>
 
-const std::set<std::string> Address::US_states
-{ "AL", "AK", "AZ", "AR", "CA", "CO", "CT", "DE", "FL", "GA"
-, "HI", "ID", "IL", "IN", "IA", "KS", "KY", "LA", "ME", "MD"
-, "MA", "MI", "MN", "MS", "MO", "MT", "NE", "NV", "NH", "NJ"
-, "NM", "NY", "NC", "ND", "OH", "OK", "OR", "PA", "RI", "SC"
-, "SD", "TN", "TX", "UT", "VT", "VA", "WA", "WV", "WI", "WY" };
-
 Address::Address( const std::string& street 
                 , const std::string& city 
                 , const std::string& state 
@@ -59,7 +53,7 @@ Address::Address( const std::string& street
         errors["State"] = Invalid_Length {_state,2,2};
         error_msg.specific_errors.push_back(invalid_address::Bad_State());
     }
-    else if(US_states.find(_state) == US_states.end() )
+    else if(!Codecs::is_us_state(_state))
     {
         errors["State"] = Invalid_Value {_state,"Us state"};
         error_msg.specific_errors.push_back(invalid_address::Bad_State());
@@ -0,0 +1,175 @@
+/*
+
+File: data_gateway.cpp
+
+Brief: Implements the lookups and change notices shared by every database connector
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <mutex>
+#include <algorithm>
+#include <ChocAn/core/id_index.hpp>
+#include <ChocAn/core/data_gateway.hpp>
+#include <ChocAn/core/service_catalog.hpp>
+#include <ChocAn/core/entities/account.hpp>
+#include <ChocAn/core/entities/service.hpp>
+#include <ChocAn/core/entities/transaction.hpp>
+
+Data_Gateway::Data_Gateway(const Data_Gateway& other)
+    : db_key    ( other.db_key )
+    , catalog     ( std::atomic_load(&other.catalog) )
+    , ids_refresh ( other.ids_refresh )
+    , observers   ( other.observers )
+    { }
+
+Data_Gateway& Data_Gateway::operator=(const Data_Gateway& other)
+{
+    if(this != &other)
+    {
+        std::atomic_store(&catalog, std::atomic_load(&other.catalog));
+        observers   = other.observers;
+        ids_refresh = other.ids_refresh;
+        ids.reset();
+    }
+    return *this;
+}
+
+Result<Account> Data_Gateway::find_account(const std::string& ID)
+{
+    Result<unsigned> key = Codecs::decode_id(ID);
+    if(!key) { return key.error(); }
+
+    std::optional<Account> account = get_account(key.value());
+    if(!account) { return Error_Code::Not_Found; }
+
+    return std::move(account.value());
+}
+
+Result<Account> Data_Gateway::find_account(const std::string& ID, Codecs::Account_Kind kind)
+{
+    Result<Account> account = find_account(ID);
+
+    if(account && account->type().index() != static_cast<size_t>(kind))
+    {
+        return Error_Code::Wrong_Type;
+    }
+    return account;
+}
+
+Result<Service> Data_Gateway::find_service(const std::string& code)
+{
+    Result<unsigned> key = Codecs::decode_id(code);
+    if(!key) { return key.error(); }
+
+    std::optional<Service> service = lookup_service(key.value());
+    if(!service) { return Error_Code::Not_Found; }
+
+    return std::move(service.value());
+}
+
+Service_Catalog::Catalog_Ptr Data_Gateway::service_catalog()
+{
+    using Shared_Catalogs = std::map<std::string, std::weak_ptr<const Service_Catalog>>;
+
+    static std::mutex      lock;
+    static Shared_Catalogs shared;
+
+    unsigned long version = services_version();
+
+    Service_Catalog::Catalog_Ptr current = std::atomic_load(&catalog);
+    if(current && current->version() == version) { return current; }
+
+    std::string store = store_id();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        current = shared[store].lock();
+    }
+    if(!current || current->version() != version)
+    {
+        // Built outside the lock, if another gateway raced us to this version its catalog is kept
+        auto built = std::make_shared<const Service_Catalog>(service_directory(), version);
+
+        std::lock_guard<std::mutex> guard(lock);
+        current = shared[store].lock();
+        if(!current || current->version() != version)
+        {
+            current = built;
+            shared[store] = current;
+        }
+        for(auto entry = shared.begin(); entry != shared.end(); )
+        {
+            entry = (entry->second.expired()) ? shared.erase(entry) : std::next(entry);
+        }
+    }
+    std::atomic_store(&catalog, current);
+    return current;
+}
+
+std::string Data_Gateway::store_id() const
+{
+    return "gateway:" + std::to_string(instance);
+}
+
+void Data_Gateway::subscribe(std::weak_ptr<Observer> observer)
+{
+    observers.push_back(std::move(observer));
+}
+
+void Data_Gateway::notify(const Change& change)
+{
+    if(ids && change.kind == Change::Kind::Account)
+    {
+        ids->apply(change);
+
+        // Read before the external version, so a write by another connection in between is not mistaken for ours
+        unsigned long version = accounts_version();
+        if(external_version() == ids_external_version) { ids->set_version(version); }
+    }
+    observers.erase(std::remove_if(observers.begin(), observers.end(), [&](const std::weak_ptr<Observer>& observer)
+    {
+        std::shared_ptr<Observer> live = observer.lock();
+        if(live) { live->on_change(change); }
+        return !live;
+    } ), observers.end());
+}
+
+Data_Gateway::Transaction_Summary Data_Gateway::summarize(const Transaction& transaction)
+{
+    return { transaction.provider().id()
+           , transaction.member().id()
+           , transaction.service().code()
+           , transaction.service_date().unix_timestamp()
+           , transaction.filed_date().unix_timestamp()
+           , transaction.service().cost().value };
+}
+
+Data_Gateway::Change Data_Gateway::account_change(const Account& account)
+{
+    Change change { Change::Kind::Account, account.id(), std::holds_alternative<Provider>(account.type()) };
+
+    change.account_kind = static_cast<Codecs::Account_Kind>(account.type().index());
+    if(const Member* member = std::get_if<Member>(&account.type()))
+    {
+        change.status = member->status();
+    }
+    return change;
+}
+
+Data_Gateway::Change Data_Gateway::transaction_change(const Transaction& transaction, unsigned number)
+{
+    return { Change::Kind::Transaction
+           , number
+           , false
+           , transaction.provider().id()
+           , transaction.member().id()
+           , transaction.service_date().unix_timestamp() };
+}
@@ -0,0 +1,164 @@
+/*
+
+File: id_bitmap.cpp
+
+Brief: ID Bitmap implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <algorithm>
+#include <ChocAn/core/utils/id_bitmap.hpp>
+
+namespace
+{
+
+constexpr size_t bitmap_words = 65536 / 64;
+
+uint16_t high_bits(uint32_t id) { return static_cast<uint16_t>(id >> 16);     }
+uint16_t low_bits(uint32_t id)  { return static_cast<uint16_t>(id & 0xFFFF); }
+
+} // namespace
+
+bool ID_Bitmap::Container::contains(uint16_t low) const
+{
+    if(dense()) { return (bits[low / 64] >> (low % 64)) & 1; }
+
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool ID_Bitmap::Container::insert(uint16_t low)
+{
+    if(dense())
+    {
+        uint64_t mask = uint64_t(1) << (low % 64);
+        if(bits[low / 64] & mask) { return false; }
+
+        bits[low / 64] |= mask;
+        ++cardinality;
+        return true;
+    }
+
+    // Bulk loads arrive in ID order, so the common case is an append
+    auto position = (array.empty() || array.back() < low) ? array.end()
+                                                          : std::lower_bound(array.begin(), array.end(), low);
+    if(position != array.end() && *position == low) { return false; }
+
+    array.insert(position, low);
+    ++cardinality;
+
+    if(array.size() > array_limit)
+    {
+        bits.assign(bitmap_words, 0);
+        for(uint16_t value : array) { bits[value / 64] |= uint64_t(1) << (value % 64); }
+
+        std::vector<uint16_t>().swap(array);
+    }
+    return true;
+}
+
+bool ID_Bitmap::Container::erase(uint16_t low)
+{
+    if(dense())
+    {
+        uint64_t mask = uint64_t(1) << (low % 64);
+        if(!(bits[low / 64] & mask)) { return false; }
+
+        bits[low / 64] &= ~mask;
+        --cardinality;
+
+        if(cardinality <= array_limit)
+        {
+            array.reserve(cardinality);
+            for(size_t word = 0; word < bits.size(); ++word)
+            {
+                for(uint64_t set = bits[word]; set; set &= set - 1)
+                {
+                    array.push_back(static_cast<uint16_t>(word * 64 + __builtin_ctzll(set)));
+                }
+            }
+            std::vector<uint64_t>().swap(bits);
+        }
+        return true;
+    }
+
+    auto position = std::lower_bound(array.begin(), array.end(), low);
+    if(position == array.end() || *position != low) { return false; }
+
+    array.erase(position);
+    --cardinality;
+    return true;
+}
+
+bool ID_Bitmap::insert(uint32_t id)
+{
+    uint16_t key = high_bits(id);
+
+    auto container = (containers.empty() || containers.back().key < key)
+                   ? containers.end()
+                   : std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, uint16_t rhs)
+                     {
+                         return lhs.key < rhs;
+                     } );
+    if(container == containers.end() || container->key != key)
+    {
+        container = containers.insert(container, Container { key });
+    }
+    if(!container->insert(low_bits(id))) { return false; }
+
+    ++count;
+    return true;
+}
+
+bool ID_Bitmap::erase(uint32_t id)
+{
+    uint16_t key = high_bits(id);
+
+    auto container = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, uint16_t rhs)
+    {
+        return lhs.key < rhs;
+    } );
+    if(container == containers.end() || container->key != key || !container->erase(low_bits(id)))
+    {
+        return false;
+    }
+    if(container->cardinality == 0) { containers.erase(container); }
+
+    --count;
+    return true;
+}
+
+bool ID_Bitmap::contains(uint32_t id) const
+{
+    uint16_t key = high_bits(id);
+
+    auto container = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, uint16_t rhs)
+    {
+        return lhs.key < rhs;
+    } );
+    return container != containers.end() && container->key == key && container->contains(low_bits(id));
+}
+
+void ID_Bitmap::clear()
+{
+    containers.clear();
+    count = 0;
+}
+
+size_t ID_Bitmap::bytes() const
+{
+    size_t total = containers.size() * sizeof(Container);
+    for(const Container& container : containers)
+    {
+        total += container.array.size() * sizeof(uint16_t) + container.bits.size() * sizeof(uint64_t);
+    }
+    return total;
+}
@@ -16,6 +16,7 @@ https://github.com/AlexanderJDupree/ChocAn
 */
 
 #include <random>
+#include <ChocAn/core/id_index.hpp>
 #include <ChocAn/core/id_generator.hpp>
 
 ID_Generator::ID_Generator(Database_Ptr db)
@@ -32,7 +33,9 @@ unsigned ID_Generator::yield() const
     thread_local static std::default_random_engine eng;
     std::uniform_int_distribution dist(100000000, 999999999);
     int id = dist(eng);
-    while(database->id_exists(id)) {
+    // Answered from the ID index. An ID another connection took within the index's refresh
+    // interval is rejected when the account is created
+    while(database->id_index().exists(id)) {
         id = dist(eng);
     }
     return id;
@@ -0,0 +1,89 @@
+/*
+
+File: id_index.cpp
+
+Brief: ID Index implementation, and the Data_Gateway index it backs
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <ChocAn/core/id_index.hpp>
+
+ID_Index::ID_Index(Data_Gateway& db, unsigned long version)
+    : _version ( version )
+{
+    for(const Data_Gateway::Account_Header& header : db.scan_account_headers())
+    {
+        put(header.id, header.kind, header.status);
+    }
+}
+
+Result<Account_Status> ID_Index::member_status(unsigned ID) const
+{
+    if(!ids.contains(ID))     { return Error_Code::Not_Found;  }
+    if(!members.contains(ID)) { return Error_Code::Wrong_Type; }
+
+    return (suspended.contains(ID)) ? Account_Status::Suspended : Account_Status::Valid;
+}
+
+void ID_Index::apply(const Data_Gateway::Change& change)
+{
+    if(change.kind != Data_Gateway::Change::Kind::Account) { return; }
+
+    if(change.account_kind)
+    {
+        put(change.id, change.account_kind.value(), change.status);
+        return;
+    }
+    ids.erase(change.id);
+    members.erase(change.id);
+    suspended.erase(change.id);
+}
+
+void ID_Index::put(unsigned ID, Codecs::Account_Kind kind, Account_Status status)
+{
+    bool member = kind == Codecs::Account_Kind::Member;
+
+    ids.insert(ID);
+    (member) ? members.insert(ID) : members.erase(ID);
+    (member && status == Account_Status::Suspended) ? suspended.insert(ID) : suspended.erase(ID);
+}
+
+const ID_Index& Data_Gateway::id_index()
+{
+    auto now = std::chrono::steady_clock::now();
+    if(ids && now - ids_checked >= ids_refresh)
+    {
+        // Only another connection's writes move the external version, the accounts version
+        // tells whether any of them touched accounts
+        unsigned long external = external_version();
+        if(external != ids_external_version)
+        {
+            if(accounts_version() != ids->version()) { ids.reset(); }
+            else { ids_external_version = external; }
+        }
+        ids_checked = now;
+    }
+    if(!ids)
+    {
+        // Versions are read before the scan, a write during it costs a rebuild rather than a missed account
+        unsigned long external = external_version();
+        ids = std::make_shared<ID_Index>(*this, accounts_version());
+        ids_external_version = external;
+        ids_checked = now;
+    }
+    return *ids;
+}
+
+Result<Account_Status> Data_Gateway::member_status(const unsigned ID)
+{
+    return id_index().member_status(ID);
+}
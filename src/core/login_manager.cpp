@@ -33,14 +33,8 @@ bool Login_Manager::login(const unsigned ID)
 
 bool Login_Manager::login(const std::string& ID)
 {
-    try
-    {
-        return login(std::stoi(ID));
-    }
-    catch(const std::exception& err)
-    {
-        return false;
-    }
+    Result<unsigned> key = Codecs::decode_id(ID);
+    return (key) ? login(key.value()) : false;
 }
 
 bool Login_Manager::logged_in() const
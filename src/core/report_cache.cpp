@@ -0,0 +1,148 @@
+/*
+
+File: report_cache.cpp
+
+Brief: Implements the report cache and its invalidation rules
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <algorithm>
+#include <ChocAn/core/report_cache.hpp>
+#include <ChocAn/core/utils/overloaded.hpp>
+
+namespace
+{
+
+// Calls visit for each account report, or for each provider line of a summary
+template <typename Visitor>
+bool any_report(const ChocAn_Report& report, Visitor visit)
+{
+    return std::visit(overloaded {
+        [&](const Summary_Report& summary)
+        {
+            return std::any_of(summary.activity().begin(), summary.activity().end(), visit);
+        },
+        [&](const Account_Report& account_report) -> bool
+        {
+            return visit(account_report);
+        }
+    }, report);
+}
+
+bool involves_account(const ChocAn_Report& report, unsigned id)
+{
+    return any_report(report, overloaded {
+        [id](const Account_Report& account_report)
+        {
+            const Account_Report::Transactions& transactions = account_report.transactions();
+            return account_report.account().id() == id
+                || std::any_of(transactions.begin(), transactions.end(), [id](const Transaction& transaction)
+                   {
+                       return transaction.provider().id() == id || transaction.member().id() == id;
+                   } );
+        },
+        [id](const Provider_Summary& line)
+        {
+            const Provider_Summary::Claims& claims = line.claims();
+            return line.account().id() == id
+                || std::any_of(claims.begin(), claims.end(), [id](const Data_Gateway::Transaction_Summary& claim)
+                   {
+                       return claim.provider_id == id || claim.member_id == id;
+                   } );
+        }
+    } );
+}
+
+bool involves_service(const ChocAn_Report& report, unsigned code)
+{
+    return any_report(report, overloaded {
+        [code](const Account_Report& account_report)
+        {
+            const Account_Report::Transactions& transactions = account_report.transactions();
+            return std::any_of(transactions.begin(), transactions.end(), [code](const Transaction& transaction)
+            {
+                return transaction.service().code() == code;
+            } );
+        },
+        [code](const Provider_Summary& line)
+        {
+            const Provider_Summary::Claims& claims = line.claims();
+            return std::any_of(claims.begin(), claims.end(), [code](const Data_Gateway::Transaction_Summary& claim)
+            {
+                return claim.service_code == code;
+            } );
+        }
+    } );
+}
+
+} // namespace
+
+Report_Cache::Report_Cache(size_t capacity)
+    : capacity ( (capacity) ? capacity : 1 )
+    { }
+
+Report_Cache::Report_Ptr Report_Cache::find(const Key& key)
+{
+    auto entry = entries.find(key);
+    if(entry == entries.end()) { return nullptr; }
+
+    entry->second.last_used = ++clock;
+    return entry->second.report;
+}
+
+void Report_Cache::insert(const Key& key, Report_Ptr report)
+{
+    if(entries.size() >= capacity && entries.find(key) == entries.end())
+    {
+        entries.erase(std::min_element(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs)
+        {
+            return lhs.second.last_used < rhs.second.last_used;
+        } ));
+    }
+    entries.insert_or_assign(key, Entry { std::move(report), ++clock });
+}
+
+void Report_Cache::clear()
+{
+    entries.clear();
+}
+
+void Report_Cache::on_change(const Change& change)
+{
+    for(auto entry = entries.begin(); entry != entries.end(); )
+    {
+        entry = (invalidated_by(entry->first, entry->second, change)) ? entries.erase(entry) : std::next(entry);
+    }
+}
+
+bool Report_Cache::invalidated_by(const Key& key, const Entry& entry, const Change& change) const
+{
+    switch (change.kind)
+    {
+    case Change::Kind::Transaction:
+        // A new row only shows up in reports whose range holds its service date
+        return key.start <= change.service_date && change.service_date <= key.end
+            && ( key.type    == Report_Type::Summary
+              || key.account == change.provider_id
+              || key.account == change.member_id );
+
+    case Change::Kind::Account:
+        // Summaries list every provider, so any provider joining or leaving changes them
+        return key.account == change.id
+            || (key.type == Report_Type::Summary && change.provider)
+            || involves_account(*entry.report, change.id);
+
+    case Change::Kind::Service:
+        return involves_service(*entry.report, change.id);
+    }
+    return true;
+}
@@ -16,16 +16,22 @@ https://github.com/AlexanderJDupree/ChocAn
  
 */
 
-#include <algorithm>
+#include <map>
+#include <stdexcept>
 #include <ChocAn/core/reporter.hpp>
 
 Reporter::Reporter(Database_Ptr db)
     : db(db)
+    , _cache(std::make_shared<Report_Cache>())
 {
     if(!db)
     {
         throw std::logic_error("Reporter: DB is null, construction failed");
     }
+    db->subscribe(_cache);
+
+    external_version = db->external_version();
+    services_version = db->services_version();
 }
 
 Provider_Report Reporter::gen_provider_report( const DateTime& start
@@ -44,16 +50,65 @@ Member_Report Reporter::gen_member_report( const DateTime&   start
 
 Summary_Report Reporter::gen_summary_report(const DateTime& start, const DateTime& end) const
 {
+    // Claims for the period [start, end] are read once, as summaries, and grouped by provider
+    std::map<unsigned, Provider_Summary::Claims> claims;
+    for(const Data_Gateway::Transaction_Summary& claim : db->transaction_summaries(start, end))
+    {
+        claims[claim.provider_id].push_back(claim);
+    }
+
+    // Providers are streamed from the DB, so only their summaries are held in memory
     Summary_Report::Provider_Activity activity;
+    for(const Account& provider : db->scan_provider_accounts())
+    {
+        auto provided = claims.find(provider.id());
+        activity.emplace_back(provider, (provided == claims.end()) ? Provider_Summary::Claims() : std::move(provided->second));
+    }
+
+    return Summary_Report(start, end, activity);
+}
 
-    // Get all provider accounts
-    Data_Gateway::Accounts provider_accounts = db->get_provider_accounts();
+template <typename Generate>
+Reporter::Report_Ptr Reporter::cached(const Report_Cache::Key& key, Generate generate)
+{
+    unsigned long external = db->external_version();
+    unsigned long services = db->services_version();
+    if(external != external_version || services != services_version)
+    {
+        _cache->clear();
+        external_version = external;
+        services_version = services;
+    }
 
-    // For each provider, generate a Provider report for the period [start, end]
-    std::for_each(provider_accounts.begin(), provider_accounts.end(), [&](const Account& provider)
+    Report_Ptr report = _cache->find(key);
+    if(!report)
     {
-        activity.push_back(gen_provider_report(start, end, provider));
+        report = std::make_shared<const ChocAn_Report>(generate());
+        _cache->insert(key, report);
+    }
+    return report;
+}
+
+Reporter::Report_Ptr Reporter::summary_report(const DateTime& start, const DateTime& end)
+{
+    return cached({ Report_Cache::Report_Type::Summary, 0, start.unix_timestamp(), end.unix_timestamp() }, [&]()
+    {
+        return ChocAn_Report(gen_summary_report(start, end));
     } );
+}
 
-    return Summary_Report(start, end, activity);
+Reporter::Report_Ptr Reporter::provider_report(const DateTime& start, const DateTime& end, const Account& provider)
+{
+    return cached({ Report_Cache::Report_Type::Provider, provider.id(), start.unix_timestamp(), end.unix_timestamp() }, [&]()
+    {
+        return ChocAn_Report(gen_provider_report(start, end, provider));
+    } );
+}
+
+Reporter::Report_Ptr Reporter::member_report(const DateTime& start, const DateTime& end, const Account& member)
+{
+    return cached({ Report_Cache::Report_Type::Member, member.id(), start.unix_timestamp(), end.unix_timestamp() }, [&]()
+    {
+        return ChocAn_Report(gen_member_report(start, end, member));
+    } );
 }
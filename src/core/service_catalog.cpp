@@ -0,0 +1,182 @@
+/*
+
+File: service_catalog.cpp
+
+Brief: Service Catalog implementation, and the Data_Gateway catalog cache
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cctype>
+#include <algorithm>
+#include <ChocAn/core/service_catalog.hpp>
+
+Service_Catalog::Service_Catalog(const Data_Gateway::Service_Directory& directory, unsigned long version)
+    : _version ( version )
+{
+    // Service_Directory is keyed by code, so this is already in code order
+    _by_code.reserve(directory.size());
+    for(const auto& entry : directory)
+    {
+        _by_code.push_back(entry.second);
+    }
+
+    _by_name = _by_code;
+    std::stable_sort(_by_name.begin(), _by_name.end(), [](const Service& lhs, const Service& rhs)
+    {
+        return lhs.name() < rhs.name();
+    } );
+
+    trigram_counts.reserve(_by_name.size());
+    for(uint32_t i = 0; i < _by_name.size(); ++i)
+    {
+        std::string name = fold(_by_name[i].name());
+
+        // Every word starts a suffix, so "rub" finds "back rub"
+        for(size_t start = 0; start != std::string::npos; )
+        {
+            word_index.emplace_back(name.substr(start), i);
+
+            size_t space = name.find(' ', start);
+            start = (space == std::string::npos) ? space : space + 1;
+        }
+
+        std::vector<std::string> grams = trigrams(name);
+        for(const std::string& gram : grams)
+        {
+            trigram_index[gram].push_back(i);
+        }
+        trigram_counts.push_back(grams.size());
+    }
+    std::sort(word_index.begin(), word_index.end());
+}
+
+std::optional<Service> Service_Catalog::lookup(unsigned code) const
+{
+    auto service = std::lower_bound(_by_code.begin(), _by_code.end(), code, [](const Service& service, unsigned code)
+    {
+        return service.code() < code;
+    } );
+    if(service == _by_code.end() || service->code() != code) { return { }; }
+
+    return *service;
+}
+
+Service_Catalog::Services Service_Catalog::prefix_search(const std::string& prefix, size_t limit) const
+{
+    std::string key = fold(prefix);
+    if(key.empty()) { return { }; }
+
+    std::vector<uint32_t> hits;
+    for(auto entry = std::lower_bound(word_index.begin(), word_index.end(), std::make_pair(key, uint32_t(0)));
+        entry != word_index.end() && entry->first.compare(0, key.length(), key) == 0; ++entry)
+    {
+        hits.push_back(entry->second);
+    }
+
+    // A name can match at more than one word
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+
+    Services matches;
+    for(size_t i = 0; i < hits.size() && i < limit; ++i)
+    {
+        matches.push_back(_by_name[hits[i]]);
+    }
+    return matches;
+}
+
+Service_Catalog::Services Service_Catalog::fuzzy_search(const std::string& query, size_t limit) const
+{
+    std::vector<std::string> grams = trigrams(fold(query));
+    if(grams.empty()) { return { }; }
+
+    std::unordered_map<uint32_t, unsigned> shared;
+    for(const std::string& gram : grams)
+    {
+        auto postings = trigram_index.find(gram);
+        if(postings == trigram_index.end()) { continue; }
+
+        for(uint32_t i : postings->second) { ++shared[i]; }
+    }
+
+    // Dice coefficient of the two trigram sets
+    std::vector<std::pair<double, uint32_t>> ranked;
+    for(const auto& candidate : shared)
+    {
+        double similarity = 2.0 * candidate.second / (grams.size() + trigram_counts[candidate.first]);
+        if(similarity >= min_similarity)
+        {
+            ranked.emplace_back(-similarity, candidate.first);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end());
+
+    Services matches;
+    for(size_t i = 0; i < ranked.size() && i < limit; ++i)
+    {
+        matches.push_back(_by_name[ranked[i].second]);
+    }
+    return matches;
+}
+
+Service_Catalog::Services Service_Catalog::search(const std::string& query, size_t limit) const
+{
+    Services matches = prefix_search(query, limit);
+    if(matches.size() >= limit) { return matches; }
+
+    for(const Service& service : fuzzy_search(query, limit))
+    {
+        auto duplicate = std::find_if(matches.begin(), matches.end(), [&](const Service& match)
+        {
+            return match.code() == service.code();
+        } );
+        if(duplicate == matches.end() && matches.size() < limit) { matches.push_back(service); }
+    }
+    return matches;
+}
+
+std::string Service_Catalog::fold(const std::string& name)
+{
+    std::string folded;
+    for(char c : name)
+    {
+        if(std::isspace(static_cast<unsigned char>(c)))
+        {
+            if(!folded.empty() && folded.back() != ' ') { folded += ' '; }
+        }
+        else
+        {
+            folded += std::tolower(static_cast<unsigned char>(c));
+        }
+    }
+    if(!folded.empty() && folded.back() == ' ') { folded.pop_back(); }
+
+    return folded;
+}
+
+std::vector<std::string> Service_Catalog::trigrams(const std::string& folded)
+{
+    if(folded.empty()) { return { }; }
+
+    // Padding lets the start and end of a name form trigrams of their own
+    std::string padded = "  " + folded + ' ';
+
+    std::vector<std::string> grams;
+    for(size_t i = 0; i + 3 <= padded.length(); ++i)
+    {
+        grams.push_back(padded.substr(i, 3));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    return grams;
+}
@@ -0,0 +1,96 @@
+/*
+
+File: tracer.cpp
+
+Brief: Tracer implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cstdio>
+#include <ChocAn/core/utils/tracer.hpp>
+
+void Tracer::record(std::string name, const char* category, Clock::time_point start, Clock::time_point end)
+{
+    using namespace std::chrono;
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    // Both ends are truncated to microseconds before taking the duration, so a nested
+    // span never appears to end after the span that contains it
+    long long begin  = duration_cast<microseconds>(start - epoch).count();
+    long long finish = duration_cast<microseconds>(end - epoch).count();
+
+    _events.push_back( { std::move(name)
+                       , category
+                       , begin
+                       , finish - begin
+                       , thread_index(std::this_thread::get_id()) } );
+}
+
+std::vector<Tracer::Event> Tracer::events() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    return _events;
+}
+
+std::string Tracer::chrome_trace() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for(size_t i = 0; i < _events.size(); ++i)
+    {
+        const Event& event = _events[i];
+
+        trace += (i) ? ",\n" : "\n";
+        trace += "{\"name\":\""  + json_escape(event.name)
+              + "\",\"cat\":\""  + json_escape(event.category)
+              + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(event.thread)
+              + ",\"ts\":"  + std::to_string(event.start)
+              + ",\"dur\":" + std::to_string(event.duration) + '}';
+    }
+    return trace += "\n]}\n";
+}
+
+unsigned Tracer::thread_index(std::thread::id id)
+{
+    // Caller holds the lock
+    return threads.emplace(id, threads.size() + 1).first->second;
+}
+
+std::string Tracer::json_escape(const std::string& str)
+{
+    std::string escaped;
+    for(char c : str)
+    {
+        switch (c)
+        {
+        case '"' : escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n";  break;
+        case '\t': escaped += "\\t";  break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", c);
+                escaped += code;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
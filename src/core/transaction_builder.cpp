@@ -15,6 +15,7 @@ https://github.com/AlexanderJDupree/ChocAn
 */
 
 #include <map>
+#include <algorithm>
 #include <functional>
 #include <ChocAn/core/utils/parsers.hpp>
 #include <ChocAn/core/utils/overloaded.hpp>
@@ -66,6 +67,12 @@ void Transaction_Builder::set_current_field(const std::string& input)
         },
         [&](const Set_Member_Acct&)
         { 
+            // Member IDs never hold the delimiter, so a line with it is a whole claim
+            if(input.find(fast_entry_delimiter) != std::string::npos)
+            {
+                set_fast_entry(input);
+                return;
+            }
             set_member_acct_field(input);
 
             if(!error) { state = Set_Service_Date(); }
@@ -97,33 +104,43 @@ const std::optional<chocan_user_exception>& Transaction_Builder::get_last_error(
 
 void Transaction_Builder::set_member_acct_field(const std::string& input)
 {
-    try
+    // Unknown, non member, and suspended IDs are turned away by the ID index without a query
+    Result<unsigned> key = Codecs::decode_id(input);
+    Result<Account_Status> status = (key) ? db->member_status(key.value()) : key.error();
+
+    if(status && status.value() == Account_Status::Suspended)
     {
-        member_acct.emplace(db->get_member_account(input).value());
+        error.emplace(chocan_user_exception("Member account is suspended", {}));
+        return;
     }
-    catch(const std::bad_optional_access&)
+
+    // The claim needs the account itself, which also has the final word on its status, the
+    // index may not yet have seen a suspension made by another connection
+    Result<Account> account = (status) ? db->find_account(input, Codecs::Account_Kind::Member) : status.error();
+
+    if(!account)
     {
         error.emplace(chocan_user_exception("Invalid ID" , { {"Member Account", Invalid_Value { input, "A 9-digit valid Member ID" }}}));
         return;
     }
-    if (std::get<Member>(member_acct.value().type()).status() == Account_Status::Suspended)
+    if (std::get<Member>(account->type()).status() == Account_Status::Suspended)
     {
         error.emplace(chocan_user_exception("Member account is suspended", {}));
         return;
     }
+    member_acct.emplace(std::move(account).value());
 }
 
 void Transaction_Builder::set_provider_acct_field(const std::string& input)
 {
-    try
-    {
-        provider_acct.emplace(db->get_provider_account(input).value());
-    }
-    catch(const std::bad_optional_access&)
+    Result<Account> account = db->find_account(input, Codecs::Account_Kind::Provider);
+
+    if(!account)
     {
         error.emplace(chocan_user_exception("No provider account associated with ID", {}));
         return;
     }
+    provider_acct.emplace(std::move(account).value());
 }
 void Transaction_Builder::set_provider_acct_field(const Account& account)
 {
@@ -154,14 +171,41 @@ void Transaction_Builder::set_service_date_field(const std::string& input)
 
 void Transaction_Builder::set_service_field(const std::string& input)
 {
-    try
+    auto catalog = db->service_catalog();
+
+    // Codes are looked up directly, anything else searches service names
+    Result<unsigned> code = Codecs::decode_id(input);
+    std::optional<Service> by_code = (code) ? catalog->lookup(code.value()) : std::nullopt;
+
+    if(by_code)
+    {
+        service.emplace(by_code.value());
+        return;
+    }
+
+    Service_Catalog::Services matches = catalog->search(input, max_service_matches);
+
+    auto exact = std::find_if(matches.begin(), matches.end(), [&](const Service& match)
     {
-        service.emplace(db->lookup_service(input).value());
+        return Service_Catalog::fold(match.name()) == Service_Catalog::fold(input);
+    } );
+    if(exact != matches.end() || matches.size() == 1)
+    {
+        service.emplace((exact != matches.end()) ? *exact : matches.front());
+        return;
     }
-    catch(const std::bad_optional_access&)
+    if(matches.empty())
     {
         error.emplace(chocan_user_exception("Invalid Service", {{"Code", Invalid_Value{input, "is not associated with a service"}}}));
+        return;
     }
+
+    chocan_user_exception::Info suggestions;
+    for(const Service& match : matches)
+    {
+        suggestions.emplace(std::to_string(match.code()), Failed_With{ match.name(), '$' + match.cost().to_string() });
+    }
+    error.emplace(chocan_user_exception("Multiple services match '" + input + "', enter a code or a more specific name", suggestions));
 }
 
 void Transaction_Builder::set_comments_field(const std::string& input)
@@ -173,3 +217,79 @@ void Transaction_Builder::set_comments_field(const std::string& input)
     }
     comments.emplace(input);
 }
+
+const std::vector<std::string> Transaction_Builder::claim_fields { "Member ID", "Service Date", "Service", "Comments" };
+
+void Transaction_Builder::set_fields(const Form& form)
+{
+    using Setter = void (Transaction_Builder::*)(const std::string&);
+
+    // Parallel to claim_fields
+    static constexpr Setter setters[] = { &Transaction_Builder::set_member_acct_field
+                                        , &Transaction_Builder::set_service_date_field
+                                        , &Transaction_Builder::set_service_field
+                                        , &Transaction_Builder::set_comments_field };
+    member_acct.reset();
+    service_date.reset();
+    service.reset();
+    comments.reset();
+
+    chocan_user_exception::Info errors;
+    size_t failed = 0;
+    for(size_t i = 0; i < claim_fields.size(); ++i)
+    {
+        auto field = form.find(claim_fields[i]);
+        const std::string input = (field == form.end()) ? "" : field->second;
+
+        // Only the comments, listed last, may be left out
+        if(input.empty() && i + 1 < claim_fields.size())
+        {
+            ++failed;
+            errors.emplace(claim_fields[i], Failed_With { input, "is required" });
+            continue;
+        }
+
+        error.reset();
+        (this->*setters[i])(input);
+        if(!error) { continue; }
+
+        ++failed;
+        errors.emplace(claim_fields[i], Failed_With { input, error->what() });
+        errors.insert(error->info().begin(), error->info().end());
+    }
+    error.reset();
+
+    if(failed)
+    {
+        error.emplace(chocan_user_exception(std::to_string(failed) + " of the claim's fields are invalid", errors));
+    }
+
+    if     (!member_acct)  { state = Set_Member_Acct();  }
+    else if(!service_date) { state = Set_Service_Date(); }
+    else if(!service)      { state = Set_Service();      }
+    else                   { state = Set_Comments();     }
+}
+
+void Transaction_Builder::set_fast_entry(const std::string& line)
+{
+    auto trim = [](const std::string& field)
+    {
+        size_t first = field.find_first_not_of(" \t");
+        size_t last  = field.find_last_not_of(" \t");
+        return (first == std::string::npos) ? std::string() : field.substr(first, last - first + 1);
+    };
+
+    Form form;
+    size_t start = 0;
+    for(size_t i = 0; i < claim_fields.size(); ++i)
+    {
+        // The last field takes the rest of the line
+        size_t end = (i + 1 < claim_fields.size()) ? line.find(fast_entry_delimiter, start) : std::string::npos;
+
+        form.emplace(claim_fields[i], trim(line.substr(start, end - start)));
+
+        if(end == std::string::npos) { break; }
+        start = end + 1;
+    }
+    set_fields(form);
+}
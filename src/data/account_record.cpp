@@ -0,0 +1,77 @@
+/*
+
+File: account_record.cpp
+
+Brief: Account Record implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <ChocAn/data/account_record.hpp>
+
+namespace
+{
+
+// Splits "<number> <name>" when printing the number back gives the same text,
+// so "0042 Main" or "12345678901 Main" are left whole
+std::pair<uint32_t, std::string_view> split_house_number(std::string_view street)
+{
+    size_t digits = street.find_first_not_of("0123456789");
+
+    if(digits == 0 || digits > 9 || digits == std::string_view::npos || street[0] == '0'
+       || street[digits] != ' ' || digits + 1 == street.size())
+    {
+        return { 0, street };
+    }
+    return { Codecs::decode_number<uint32_t>(street.substr(0, digits)).value(), street.substr(digits + 1) };
+}
+
+} // namespace
+
+Account_Record::Account_Record(const Account& account, String_Pool& pool)
+    : _id      ( account.id() )
+    , _first   ( pool.intern(account.name().first()) )
+    , _last    ( pool.intern(account.name().last()) )
+    , _city    ( pool.intern(account.address().city()) )
+    , _zip     ( account.address().zip() )
+    , _state   ( Codecs::encode_state(account.address().state()) )
+    , _kind    ( static_cast<uint16_t>(account.type().index()) )
+    , _status  ( 0 )
+{
+    auto [number, name] = split_house_number(account.address().street());
+    _house_number = number;
+    _street       = pool.intern(name);
+
+    if(const Member* member = std::get_if<Member>(&account.type()))
+    {
+        _status = static_cast<uint16_t>(member->status());
+    }
+}
+
+Account Account_Record::unpack(const String_Pool& pool, const Key<Data_Gateway>& key) const
+{
+    std::string street = (_house_number) ? std::to_string(_house_number) + ' ' + pool.at(_street)
+                                         : pool.at(_street);
+
+    Account::Account_Type type;
+    switch (kind())
+    {
+    case Codecs::Account_Kind::Manager  : type = Manager();          break;
+    case Codecs::Account_Kind::Member   : type = Member(status());   break;
+    case Codecs::Account_Kind::Provider : type = Provider();         break;
+    }
+
+    return Account( Name(pool.at(_first), pool.at(_last))
+                  , Address(street, pool.at(_city), Codecs::decode_state(_state), _zip)
+                  , std::move(type)
+                  , _id
+                  , key );
+}
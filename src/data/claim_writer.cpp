@@ -0,0 +1,97 @@
+/*
+
+File: claim_writer.cpp
+
+Brief: Claim Writer implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/data/claim_writer.hpp>
+
+Claim_Writer::Claim_Writer(std::shared_ptr<SQLite_DB> db, Duration window, size_t max_group)
+    : db        ( db )
+    , window    ( window )
+    , max_group ( (max_group) ? max_group : 1 )
+    , writer    ( &Claim_Writer::run, this )
+    {}
+
+Claim_Writer::~Claim_Writer()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    arrived.notify_one();
+    writer.join();
+}
+
+std::future<unsigned> Claim_Writer::submit(const Transaction& claim)
+{
+    Pending pending { claim, std::promise<unsigned>(), Clock::now() };
+    std::future<unsigned> id = pending.id.get_future();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back(std::move(pending));
+    }
+    arrived.notify_one();
+    return id;
+}
+
+Claim_Writer::Stats Claim_Writer::stats() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return totals;
+}
+
+void Claim_Writer::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while(true)
+    {
+        arrived.wait(guard, [&](){ return stopping || !queue.empty(); });
+
+        if(queue.empty()) { return; }
+
+        // Hold the group open so claims from other sessions can join it, the first claim
+        // in the group waits at most one window before its commit starts
+        arrived.wait_until(guard, queue.front().submitted + window, [&]()
+        {
+            return stopping || queue.size() >= max_group;
+        } );
+
+        size_t size = std::min(queue.size(), max_group);
+        std::vector<Pending> group( std::make_move_iterator(queue.begin())
+                                  , std::make_move_iterator(queue.begin() + size) );
+        queue.erase(queue.begin(), queue.begin() + size);
+
+        guard.unlock();
+
+        Data_Gateway::Transactions claims;
+        claims.reserve(group.size());
+        for(const Pending& pending : group) { claims.push_back(pending.claim); }
+
+        std::vector<unsigned> ids = db->add_transactions(claims);
+
+        guard.lock();
+
+        // Count the commit before any claim resolves, so callers that waited see it in stats
+        totals.claims  += group.size();
+        totals.commits += 1;
+        totals.largest  = std::max(totals.largest, group.size());
+
+        for(size_t i = 0; i < group.size(); ++i) { group[i].id.set_value(ids[i]); }
+    }
+}
@@ -0,0 +1,407 @@
+/*
+
+File: log_db.cpp
+
+Brief: Log DB implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <ChocAn/data/log_db.hpp>
+#include <ChocAn/core/utils/exception.hpp>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+Log_DB::Log_DB(const std::string& directory, Sync_Policy sync)
+    : sync        ( sync )
+    , account_log ( directory, "accounts" )
+    , claim_log   ( directory, "claims" )
+{
+    auto replay = [&](Record_Type type, const std::string& payload) { apply(type, payload); };
+
+    account_log.replay(replay);
+    claim_log.replay(replay);
+}
+
+Log_DB::~Log_DB()
+{
+    flush();
+}
+
+bool Log_DB::update_account(const Account& account)
+{
+    bool superseded = id_exists(account.id());
+
+    if(!append(account_log, Record_Type::Account_Put, Record_Codec::encode(account)))
+    {
+        return false;
+    }
+    dead += (superseded) ? 1 : 0;
+
+    Memory_DB::update_account(account);
+
+    compact_if_needed();
+    return true;
+}
+
+unsigned Log_DB::create_account(const Account& account)
+{
+    if(id_exists(account.id())) { return 0; }
+
+    return (update_account(account)) ? account.id() : 0;
+}
+
+bool Log_DB::delete_account(const unsigned ID)
+{
+    if(!id_exists(ID)) { return false; }
+
+    if(!append(account_log, Record_Type::Account_Delete, Record_Codec::encode({ { "chocan_id", std::to_string(ID) } })))
+    {
+        return false;
+    }
+    // Both the tombstone and the record it deletes are dead
+    dead += 2;
+
+    Memory_DB::delete_account(ID);
+
+    compact_if_needed();
+    return true;
+}
+
+unsigned Log_DB::add_transaction(const Transaction& transaction)
+{
+    if(is_filed(transaction)) { return 0; }
+
+    if(!append(claim_log, Record_Type::Transaction, Record_Codec::encode(transaction)))
+    {
+        return 0;
+    }
+    return Memory_DB::add_transaction(transaction);
+}
+
+bool Log_DB::add_service(const Service& service)
+{
+    bool superseded = services.find(service.code()) != services.end();
+
+    if(!append(account_log, Record_Type::Service_Put, Record_Codec::encode(service)))
+    {
+        return false;
+    }
+    dead += (superseded) ? 1 : 0;
+
+    Memory_DB::add_service(service);
+
+    compact_if_needed();
+    return true;
+}
+
+void Log_DB::import(Data_Gateway& source)
+{
+    Tracer::Span span(tracer.get(), "Log_DB::import", "db");
+
+    account_log.begin_batch();
+    claim_log.begin_batch();
+
+    Memory_DB::import(source);
+
+    bool accounts_written = account_log.commit_batch();
+    bool claims_written   = claim_log.commit_batch();
+    if(!accounts_written || !claims_written)
+    {
+        throw chocan_db_exception("Unable to write imported records", { { "error", std::strerror(errno) } });
+    }
+}
+
+bool Log_DB::compact()
+{
+    Tracer::Span span(tracer.get(), "Log_DB::compact", "db");
+
+    std::string records = Record_Codec::frame(Record_Type::Snapshot, "");
+
+    for(const auto& account : accounts)
+    {
+        records += Record_Codec::frame(Record_Type::Account_Put, Record_Codec::encode(account_at(account.first)));
+    }
+    for(const auto& service : services)
+    {
+        records += Record_Codec::frame(Record_Type::Service_Put, Record_Codec::encode(service.second));
+    }
+    if(!account_log.rewrite(records)) { return false; }
+
+    dead = 0;
+    return true;
+}
+
+bool Log_DB::flush()
+{
+    Tracer::Span span(tracer.get(), "Log_DB::flush", "db");
+
+    bool accounts_synced = account_log.sync();
+    bool claims_synced   = claim_log.sync();
+
+    return accounts_synced && claims_synced;
+}
+
+bool Log_DB::append(Segment_Log& log, Record_Type type, const std::string& payload)
+{
+    Tracer::Span span(tracer.get(), "Log_DB::append", "db");
+
+    return log.append(type, payload, sync);
+}
+
+void Log_DB::compact_if_needed()
+{
+    if(dead > compaction_threshold && dead > accounts.size() + services.size())
+    {
+        compact();
+    }
+}
+
+void Log_DB::apply(Record_Type type, const std::string& payload)
+{
+    bool superseded = Memory_DB::apply_record(type, payload);
+
+    // Track how many account log records a compaction would drop
+    switch (type)
+    {
+    case Record_Type::Snapshot:       dead = 0; break;
+    case Record_Type::Account_Delete: dead += (superseded) ? 2 : 1; break;
+    case Record_Type::Account_Put:
+    case Record_Type::Service_Put:    dead += (superseded) ? 1 : 0; break;
+    case Record_Type::Transaction:    break;
+    }
+}
+
+Log_DB::Segment_Log::Segment_Log(const std::string& directory, const std::string& name)
+    : directory ( directory )
+    , name      ( name )
+{
+    std::error_code err;
+    fs::create_directories(directory, err);
+    if(!fs::is_directory(directory, err))
+    {
+        throw chocan_db_exception("Unable to open log directory", { { "directory", directory } });
+    }
+}
+
+Log_DB::Segment_Log::~Segment_Log()
+{
+    if(fd >= 0) { ::close(fd); }
+}
+
+std::string Log_DB::Segment_Log::segment_path(unsigned number) const
+{
+    char file_name[32];
+    std::snprintf(file_name, sizeof(file_name), "-%08u.log", number);
+
+    return (fs::path(directory) / (name + file_name)).string();
+}
+
+std::vector<unsigned> Log_DB::Segment_Log::segment_numbers() const
+{
+    std::vector<unsigned> numbers;
+    for(const auto& entry : fs::directory_iterator(directory))
+    {
+        std::string file_name = entry.path().filename().string();
+        if(file_name.compare(0, name.length() + 1, name + '-') != 0) { continue; }
+
+        // Left over from a compaction that did not finish
+        if(entry.path().extension() == ".tmp")
+        {
+            fs::remove(entry.path());
+            continue;
+        }
+        unsigned number = 0;
+        char extension[5] = {};
+        if(std::sscanf(file_name.c_str() + name.length(), "-%8u.%4s", &number, extension) == 2
+           && std::string(extension) == "log")
+        {
+            numbers.push_back(number);
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+template <typename Apply>
+void Log_DB::Segment_Log::replay(Apply apply)
+{
+    std::vector<unsigned> numbers = segment_numbers();
+
+    // Everything before the latest snapshot is superseded by it
+    auto start = numbers.begin();
+    for(auto it = numbers.rbegin(); it != numbers.rend(); ++it)
+    {
+        std::ifstream segment(segment_path(*it), std::ios::binary);
+
+        char header[Record_Codec::header_size];
+        if(segment.read(header, Record_Codec::header_size) && header[8] == static_cast<char>(Record_Type::Snapshot))
+        {
+            start = it.base() - 1;
+            break;
+        }
+    }
+    for(auto it = numbers.begin(); it != start; ++it)
+    {
+        fs::remove(segment_path(*it));
+    }
+
+    for(auto it = start; it != numbers.end(); ++it)
+    {
+        std::string path = segment_path(*it);
+        std::string data = read_file(path);
+
+        size_t offset = Record_Codec::parse(data, apply);
+        if(offset != data.length())
+        {
+            // A torn write can only be at the tail of the active segment
+            if(it + 1 != numbers.end())
+            {
+                throw chocan_db_exception("Corrupt log segment", { { "segment", path }
+                                                                 , { "offset",  std::to_string(offset) } });
+            }
+            fs::resize_file(path, offset);
+        }
+    }
+
+    if(!open_segment((numbers.empty()) ? 1 : numbers.back()))
+    {
+        throw chocan_db_exception("Unable to open log segment", { { "segment", segment_path(active) } });
+    }
+}
+
+bool Log_DB::Segment_Log::open_segment(unsigned number)
+{
+    if(fd >= 0) { ::close(fd); }
+
+    active = number;
+    fd     = ::open(segment_path(number).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if(fd < 0) { return false; }
+
+    off_t end = ::lseek(fd, 0, SEEK_END);
+    size = (end > 0) ? end : 0;
+    if(size == 0) { Record_Codec::sync_directory(directory); }
+
+    return true;
+}
+
+bool Log_DB::Segment_Log::append(Record_Type type, const std::string& payload, Sync_Policy sync_policy)
+{
+    if(fd < 0 || payload.length() > Record_Codec::max_record_size) { return false; }
+
+    if(batching)
+    {
+        batch += Record_Codec::frame(type, payload);
+        ++batched;
+        return true;
+    }
+    return write(Record_Codec::frame(type, payload), 1, sync_policy);
+}
+
+void Log_DB::Segment_Log::begin_batch()
+{
+    batching = true;
+}
+
+bool Log_DB::Segment_Log::commit_batch()
+{
+    batching = false;
+
+    std::string records = std::move(batch);
+    size_t      count   = std::exchange(batched, 0);
+    batch.clear();
+
+    return records.empty() || write(records, count, Sync_Policy::Always);
+}
+
+bool Log_DB::Segment_Log::write(const std::string& records, size_t count, Sync_Policy sync_policy)
+{
+    if(fd < 0) { return false; }
+
+    if(size >= segment_size && !(sync() && open_segment(active + 1)))
+    {
+        return false;
+    }
+
+    // Never leave a record the caller was told failed, replay would still apply it
+    size_t start    = size;
+    auto   rollback = [&]()
+    {
+        if(::ftruncate(fd, static_cast<off_t>(start)) != 0) { ::close(fd); fd = -1; }
+        size = start;
+        return false;
+    };
+
+    size_t written = 0;
+    while(written < records.length())
+    {
+        ssize_t result = ::write(fd, records.data() + written, records.length() - written);
+        if(result < 0 && errno == EINTR) { continue; }
+        if(result < 0)                   { return rollback(); }
+
+        written += result;
+    }
+    size    += records.length();
+    pending += count;
+
+    bool synced = true;
+    switch (sync_policy)
+    {
+    case Sync_Policy::Always: synced = sync(); break;
+    case Sync_Policy::Batch:  synced = (pending >= batch_size) ? sync() : true; break;
+    case Sync_Policy::Never:  break;
+    }
+    return (synced) ? true : rollback();
+}
+
+bool Log_DB::Segment_Log::sync()
+{
+    if(fd < 0)       { return false; }
+    if(pending == 0) { return true;  }
+
+    pending = 0;
+    return ::fdatasync(fd) == 0;
+}
+
+bool Log_DB::Segment_Log::rewrite(const std::string& records)
+{
+    unsigned number = active + 1;
+
+    if(!Record_Codec::write_atomic(segment_path(number), records)) { return false; }
+
+    std::vector<unsigned> numbers = segment_numbers();
+    if(!open_segment(number)) { return false; }
+
+    for(unsigned old : numbers)
+    {
+        if(old < number) { fs::remove(segment_path(old)); }
+    }
+    return true;
+}
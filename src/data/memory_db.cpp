@@ -0,0 +1,652 @@
+/*
+
+File: memory_db.cpp
+
+Brief: Memory DB implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <ChocAn/data/memory_db.hpp>
+#include <ChocAn/core/utils/exception.hpp>
+
+Memory_DB::Memory_DB(Data_Gateway& source)
+{
+    import(source);
+}
+
+void Memory_DB::import(Data_Gateway& source)
+{
+    for(const Account& account : source.scan_manager_accounts())  { update_account(account); }
+    for(const Account& account : source.scan_provider_accounts()) { update_account(account); }
+    for(const Account& account : source.scan_member_accounts())   { update_account(account); }
+
+    for(const auto& service : source.service_directory())
+    {
+        add_service(service.second);
+    }
+    for(const Transaction& transaction : source.scan_transactions(DateTime(0.0), DateTime::get_current_datetime()))
+    {
+        add_transaction(transaction);
+    }
+}
+
+bool Memory_DB::save_snapshot(const std::string& path) const
+{
+    std::string data = Record_Codec::frame(Record_Type::Snapshot, "");
+
+    for(const auto& account : accounts)
+    {
+        data += Record_Codec::frame(Record_Type::Account_Put, Record_Codec::encode(account_at(account.first)));
+    }
+    for(const auto& service : services)
+    {
+        data += Record_Codec::frame(Record_Type::Service_Put, Record_Codec::encode(service.second));
+    }
+    for(const Transaction& transaction : transactions)
+    {
+        data += Record_Codec::frame(Record_Type::Transaction, Record_Codec::encode(transaction));
+    }
+    return Record_Codec::write_atomic(path, data);
+}
+
+bool Memory_DB::load_snapshot(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file.is_open()) { return false; }
+
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if(data.length() < Record_Codec::header_size || data[8] != static_cast<char>(Record_Type::Snapshot))
+    {
+        return false;
+    }
+
+    // Records are applied to a scratch store, so a bad one part way through changes nothing
+    Memory_DB scratch;
+    try
+    {
+        auto apply = [&](Record_Type type, const std::string& payload) { scratch.apply_record(type, payload); };
+
+        if(Record_Codec::parse(data, apply) != data.length()) { return false; }
+    }
+    catch(const chocan_db_exception&)
+    {
+        return false;
+    }
+
+    swap_contents(scratch);
+
+    service_version = std::max(service_version, scratch.service_version) + 1;
+    ++snapshots_loaded;
+    reset_id_index();
+    return true;
+}
+
+void Memory_DB::swap_contents(Memory_DB& other)
+{
+    std::swap(accounts,  other.accounts);
+    std::swap(strings,   other.strings);
+    std::swap(members,   other.members);
+    std::swap(providers, other.providers);
+    std::swap(managers,  other.managers);
+    std::swap(tokens,    other.tokens);
+    std::swap(services,  other.services);
+
+    std::swap(transactions,    other.transactions);
+    std::swap(filed,           other.filed);
+    std::swap(by_service_date, other.by_service_date);
+    std::swap(by_account,      other.by_account);
+}
+
+bool Memory_DB::apply_record(Record_Type type, const std::string& payload)
+{
+    auto malformed = [](Error_Code err)
+    {
+        return chocan_db_exception("Malformed record", { { "error", to_string(err) } });
+    };
+
+    switch (type)
+    {
+    case Record_Type::Snapshot:
+        return false;
+    case Record_Type::Account_Put:
+    {
+        Result<Account> account = Record_Codec::decode_account(payload, db_key);
+        if(!account) { throw malformed(account.error()); }
+
+        bool superseded = id_exists(account->id());
+        Memory_DB::update_account(account.value());
+        return superseded;
+    }
+    case Record_Type::Account_Delete:
+    {
+        Result<Record_Codec::Data_Table> data = Record_Codec::decode(payload);
+        auto id = (data && data->count("chocan_id")) ? Codecs::decode_id(data->at("chocan_id")) : Error_Code::Malformed_Row;
+        if(!id) { throw malformed(id.error()); }
+
+        return Memory_DB::delete_account(id.value());
+    }
+    case Record_Type::Service_Put:
+    {
+        Result<Service> service = Record_Codec::decode_service(payload, db_key);
+        if(!service) { throw malformed(service.error()); }
+
+        bool superseded = services.find(service->code()) != services.end();
+        Memory_DB::add_service(service.value());
+        return superseded;
+    }
+    case Record_Type::Transaction:
+    {
+        Result<Transaction> transaction = Record_Codec::decode_transaction(payload, db_key);
+        if(!transaction) { throw malformed(transaction.error()); }
+
+        Memory_DB::add_transaction(transaction.value());
+        return false;
+    }
+    }
+    throw chocan_db_exception("Unknown record type", { { "type", std::to_string(static_cast<int>(type)) } });
+}
+
+bool Memory_DB::update_account(const Account& account)
+{
+    unsigned id = account.id();
+
+    auto existing = accounts.find(id);
+    if(existing != accounts.end())
+    {
+        // Account type may have changed, drop it from its old type index
+        type_index(existing->second.kind()).erase(id);
+        index_tokens(account_at(id), false);
+        existing->second = Account_Record(account, strings);
+    }
+    else
+    {
+        accounts.emplace(id, Account_Record(account, strings));
+    }
+    type_index(static_cast<Codecs::Account_Kind>(account.type().index())).insert(id);
+    index_tokens(account, true);
+
+    notify(account_change(account));
+    return true;
+}
+
+unsigned Memory_DB::create_account(const Account& account)
+{
+    if(id_exists(account.id())) { return 0; }
+
+    return (update_account(account)) ? account.id() : 0;
+}
+
+bool Memory_DB::delete_account(const unsigned ID)
+{
+    auto record = accounts.find(ID);
+    if(record == accounts.end()) { return false; }
+
+    Change change { Change::Kind::Account, ID, record->second.kind() == Codecs::Account_Kind::Provider };
+
+    type_index(record->second.kind()).erase(ID);
+    index_tokens(account_at(ID), false);
+
+    accounts.erase(record);
+
+    notify(change);
+    return true;
+}
+
+unsigned Memory_DB::add_transaction(const Transaction& transaction)
+{
+    if(!filed.insert(transaction_key(transaction)).second) { return 0; }
+
+    size_t slot = transactions.size();
+    int service_date = transaction.service_date().unix_timestamp();
+
+    transactions.push_back(transaction);
+
+    by_service_date.emplace(service_date, slot);
+    by_account[transaction.provider().id()].emplace(service_date, slot);
+    by_account[transaction.member().id()].emplace(service_date, slot);
+
+    notify(transaction_change(transaction, slot + 1));
+    return slot + 1;
+}
+
+bool Memory_DB::add_service(const Service& service)
+{
+    services.insert_or_assign(service.code(), service);
+    ++service_version;
+
+    notify({ Change::Kind::Service, service.code() });
+    return true;
+}
+
+Memory_DB::ID_Set& Memory_DB::type_index(Codecs::Account_Kind kind)
+{
+    switch (kind)
+    {
+    case Codecs::Account_Kind::Manager  : return managers;
+    case Codecs::Account_Kind::Provider : return providers;
+    case Codecs::Account_Kind::Member   : break;
+    }
+    return members;
+}
+
+Account Memory_DB::account_at(const unsigned ID) const
+{
+    return accounts.at(ID).unpack(strings, db_key);
+}
+
+void Memory_DB::index_tokens(const Account& account, bool insert)
+{
+    const Name&    name    = account.name();
+    const Address& address = account.address();
+
+    for(const std::string& field : { name.first(), name.last(), address.street(), address.city()
+                                   , address.state(), std::to_string(address.zip()) })
+    {
+        for(const std::string& token : tokenize(field))
+        {
+            if(insert)
+            {
+                tokens[token].insert(account.id());
+                continue;
+            }
+            auto entry = tokens.find(token);
+            if(entry != tokens.end() && entry->second.erase(account.id()) && entry->second.empty())
+            {
+                tokens.erase(entry);
+            }
+        }
+    }
+}
+
+std::vector<std::string> Memory_DB::tokenize(const std::string& text)
+{
+    std::vector<std::string> words;
+    std::string word;
+    for(char c : text)
+    {
+        if(std::isalnum(static_cast<unsigned char>(c)))
+        {
+            word += std::tolower(static_cast<unsigned char>(c));
+        }
+        else if(!word.empty())
+        {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if(!word.empty()) { words.push_back(std::move(word)); }
+
+    return words;
+}
+
+std::optional<Account> Memory_DB::lookup_typed(const unsigned ID, Codecs::Account_Kind kind) const
+{
+    auto account = accounts.find(ID);
+    if(account == accounts.end() || account->second.kind() != kind)
+    {
+        return { };
+    }
+    return account->second.unpack(strings, db_key);
+}
+
+std::optional<unsigned> Memory_DB::parse_key(const std::string& key)
+{
+    return Codecs::decode_id(key).to_optional();
+}
+
+std::string Memory_DB::transaction_key(const Transaction& transaction)
+{
+    return std::to_string(transaction.filed_date().unix_timestamp())   + ':'
+         + std::to_string(transaction.service_date().unix_timestamp()) + ':'
+         + std::to_string(transaction.provider().id()) + ':'
+         + std::to_string(transaction.member().id())   + ':'
+         + std::to_string(transaction.service().code());
+}
+
+bool Memory_DB::is_filed(const Transaction& transaction) const
+{
+    return filed.find(transaction_key(transaction)) != filed.end();
+}
+
+bool Memory_DB::has_accounts(const Transaction& transaction) const
+{
+    return providers.count(transaction.provider().id()) && members.count(transaction.member().id());
+}
+
+std::optional<Account> Memory_DB::get_account(const unsigned ID)
+{
+    auto account = accounts.find(ID);
+    if(account == accounts.end()) { return { }; }
+
+    return account->second.unpack(strings, db_key);
+}
+
+std::optional<Account> Memory_DB::get_account(const std::string& ID)
+{
+    auto key = parse_key(ID);
+    return (key) ? get_account(key.value()) : std::nullopt;
+}
+
+std::optional<Account> Memory_DB::get_member_account(const unsigned ID)
+{
+    return lookup_typed(ID, Codecs::Account_Kind::Member);
+}
+
+std::optional<Account> Memory_DB::get_member_account(const std::string& ID)
+{
+    auto key = parse_key(ID);
+    return (key) ? get_member_account(key.value()) : std::nullopt;
+}
+
+std::optional<Account> Memory_DB::get_provider_account(const unsigned ID)
+{
+    return lookup_typed(ID, Codecs::Account_Kind::Provider);
+}
+
+std::optional<Account> Memory_DB::get_provider_account(const std::string& ID)
+{
+    auto key = parse_key(ID);
+    return (key) ? get_provider_account(key.value()) : std::nullopt;
+}
+
+std::optional<Account> Memory_DB::get_manager_account(const unsigned ID)
+{
+    return lookup_typed(ID, Codecs::Account_Kind::Manager);
+}
+
+std::optional<Account> Memory_DB::get_manager_account(const std::string& ID)
+{
+    auto key = parse_key(ID);
+    return (key) ? get_manager_account(key.value()) : std::nullopt;
+}
+
+std::optional<Service> Memory_DB::lookup_service(const unsigned code)
+{
+    auto service = services.find(code);
+    if(service == services.end()) { return { }; }
+
+    return service->second;
+}
+
+std::optional<Service> Memory_DB::lookup_service(const std::string& code)
+{
+    auto key = parse_key(code);
+    return (key) ? lookup_service(key.value()) : std::nullopt;
+}
+
+Data_Gateway::Service_Directory Memory_DB::service_directory()
+{
+    return Service_Directory(services.begin(), services.end());
+}
+
+bool Memory_DB::id_exists(const unsigned ID) const
+{
+    return accounts.find(ID) != accounts.end();
+}
+
+Data_Gateway::Transactions Memory_DB::collect(const Date_Index& index, DateTime start, DateTime end) const
+{
+    Transactions range;
+
+    auto first = index.lower_bound(start.unix_timestamp());
+    auto last  = index.upper_bound(end.unix_timestamp());
+    for(; first != last; ++first)
+    {
+        const Transaction& transaction = transactions[first->second];
+        if(has_accounts(transaction)) { range.push_back(transaction); }
+    }
+    return range;
+}
+
+Data_Gateway::Transactions Memory_DB::get_transactions(DateTime start, DateTime end, Account acct)
+{
+    Tracer::Span span(tracer.get(), "Memory_DB::get_transactions", "db");
+
+    // Managers have access to every transaction
+    if(std::holds_alternative<Manager>(acct.type()))
+    {
+        return get_transactions(start, end);
+    }
+    auto postings = by_account.find(acct.id());
+    if(postings == by_account.end())
+    {
+        return { };
+    }
+    return collect(postings->second, start, end);
+}
+
+Data_Gateway::Transactions Memory_DB::get_transactions(DateTime start, DateTime end)
+{
+    Tracer::Span span(tracer.get(), "Memory_DB::get_transactions", "db");
+
+    return collect(by_service_date, start, end);
+}
+
+Data_Gateway::Accounts Memory_DB::collect(const ID_Set& ids) const
+{
+    Accounts list;
+    list.reserve(ids.size());
+    for(unsigned id : ids)
+    {
+        list.push_back(account_at(id));
+    }
+    return list;
+}
+
+Data_Gateway::Accounts Memory_DB::get_member_accounts()
+{
+    return collect(members);
+}
+
+Data_Gateway::Accounts Memory_DB::get_provider_accounts()
+{
+    return collect(providers);
+}
+
+Data_Gateway::Accounts Memory_DB::get_manager_accounts()
+{
+    return collect(managers);
+}
+
+Data_Gateway::Account_Cursor Memory_DB::scan(const ID_Set& ids) const
+{
+    return Account_Cursor([this, &ids, last = std::optional<unsigned>()](size_t limit) mutable
+    {
+        Accounts batch;
+        for(auto id = (last) ? ids.upper_bound(*last) : ids.begin(); id != ids.end() && batch.size() < limit; ++id)
+        {
+            batch.push_back(account_at(*id));
+        }
+        if(!batch.empty()) { last = batch.back().id(); }
+
+        return batch;
+    } );
+}
+
+Data_Gateway::Transaction_Cursor Memory_DB::scan(const Date_Index& index, DateTime start, DateTime end) const
+{
+    using Key = std::pair<int, size_t>;
+
+    int first = start.unix_timestamp();
+    int last  = end.unix_timestamp();
+
+    // Slots only grow, so (service date, slot) orders transactions filed on the same date
+    return Transaction_Cursor([this, &index, first, last, resume = std::optional<Key>()](size_t limit) mutable
+    {
+        auto entry = index.lower_bound((resume) ? resume->first : first);
+        while(resume && entry != index.end() && entry->first == resume->first && entry->second <= resume->second)
+        {
+            ++entry;
+        }
+
+        Transactions batch;
+        for(; entry != index.end() && entry->first <= last && batch.size() < limit; ++entry)
+        {
+            const Transaction& transaction = transactions[entry->second];
+            if(has_accounts(transaction)) { batch.push_back(transaction); }
+            resume = *entry;
+        }
+        return batch;
+    } );
+}
+
+Data_Gateway::Account_Cursor Memory_DB::scan_member_accounts()
+{
+    return scan(members);
+}
+
+Data_Gateway::Account_Cursor Memory_DB::scan_provider_accounts()
+{
+    return scan(providers);
+}
+
+Data_Gateway::Account_Cursor Memory_DB::scan_manager_accounts()
+{
+    return scan(managers);
+}
+
+Data_Gateway::Transaction_Cursor Memory_DB::scan_transactions(DateTime start, DateTime end, Account acct)
+{
+    // Managers have access to every transaction
+    if(std::holds_alternative<Manager>(acct.type()))
+    {
+        return scan_transactions(start, end);
+    }
+    auto postings = by_account.find(acct.id());
+    if(postings == by_account.end())
+    {
+        return Transaction_Cursor::empty();
+    }
+    return scan(postings->second, start, end);
+}
+
+Data_Gateway::Transaction_Cursor Memory_DB::scan_transactions(DateTime start, DateTime end)
+{
+    return scan(by_service_date, start, end);
+}
+
+Data_Gateway::Transaction_Summaries Memory_DB::transaction_summaries(DateTime start, DateTime end)
+{
+    Tracer::Span span(tracer.get(), "Memory_DB::transaction_summaries", "db");
+
+    Transaction_Summaries summaries;
+
+    auto first = by_service_date.lower_bound(start.unix_timestamp());
+    auto last  = by_service_date.upper_bound(end.unix_timestamp());
+    for(; first != last; ++first)
+    {
+        const Transaction& transaction = transactions[first->second];
+        if(has_accounts(transaction)) { summaries.push_back(summarize(transaction)); }
+    }
+    return summaries;
+}
+
+std::optional<Data_Gateway::Account_Header> Memory_DB::account_header(const unsigned ID)
+{
+    auto account = accounts.find(ID);
+    if(account == accounts.end()) { return { }; }
+
+    return Account_Header { ID, account->second.kind(), account->second.status() };
+}
+
+Data_Gateway::Header_Cursor Memory_DB::scan_account_headers()
+{
+    return Header_Cursor([this, last = std::optional<unsigned>()](size_t limit) mutable
+    {
+        const ID_Set* indexes[] = { &managers, &providers, &members };
+
+        ID_Set::const_iterator next[3];
+        for(size_t i = 0; i < 3; ++i)
+        {
+            next[i] = (last) ? indexes[i]->upper_bound(*last) : indexes[i]->begin();
+        }
+
+        Header_Cursor::Batch batch;
+        while(batch.size() < limit)
+        {
+            // The lowest ID not yet returned heads one of the indexes
+            std::optional<size_t> lowest;
+            for(size_t i = 0; i < 3; ++i)
+            {
+                if(next[i] != indexes[i]->end() && (!lowest || *next[i] < *next[*lowest])) { lowest = i; }
+            }
+            if(!lowest) { break; }
+
+            unsigned id = *next[*lowest]++;
+            batch.push_back(account_header(id).value());
+        }
+        if(!batch.empty()) { last = batch.back().id; }
+
+        return batch;
+    } );
+}
+
+Data_Gateway::Accounts Memory_DB::search_accounts(const std::string& query, size_t limit)
+{
+    Tracer::Span span(tracer.get(), "Memory_DB::search_accounts", "db");
+
+    using Scores = std::map<unsigned, unsigned>;
+
+    std::vector<std::string> terms = tokenize(query);
+    if(terms.empty() || limit == 0) { return { }; }
+
+    // Every term must prefix a word of the account, a whole word scores higher
+    std::optional<Scores> scores;
+    for(const std::string& term : terms)
+    {
+        Scores matched;
+        for(auto entry = tokens.lower_bound(term);
+            entry != tokens.end() && entry->first.compare(0, term.length(), term) == 0; ++entry)
+        {
+            unsigned score = (entry->first.length() == term.length()) ? 2 : 1;
+            for(unsigned id : entry->second)
+            {
+                unsigned& best = matched[id];
+                best = std::max(best, score);
+            }
+        }
+        if(scores)
+        {
+            for(auto entry = scores->begin(); entry != scores->end(); )
+            {
+                auto match = matched.find(entry->first);
+                if(match == matched.end()) { entry = scores->erase(entry); continue; }
+
+                entry->second += match->second;
+                ++entry;
+            }
+        }
+        else
+        {
+            scores = std::move(matched);
+        }
+        if(scores->empty()) { return { }; }
+    }
+
+    std::vector<std::pair<unsigned, unsigned>> ranked(scores->begin(), scores->end());
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs)
+    {
+        return lhs.second > rhs.second;
+    } );
+
+    Accounts results;
+    for(size_t i = 0; i < ranked.size() && i < limit; ++i)
+    {
+        results.push_back(account_at(ranked[i].first));
+    }
+    return results;
+}
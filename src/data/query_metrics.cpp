@@ -0,0 +1,128 @@
+/*
+
+File: query_metrics.cpp
+
+Brief: Query Metrics implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+#include <ChocAn/data/query_metrics.hpp>
+
+std::string Query_Metrics::normalize(const std::string& sql)
+{
+    auto is_identifier = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+    std::string shape;
+    for(size_t i = 0; i < sql.length() && shape.length() < max_shape_length; ++i)
+    {
+        char c = sql[i];
+        if(c == '\'')
+        {
+            // Skip to the closing quote, '' is an escaped quote
+            for(++i; i < sql.length(); ++i)
+            {
+                if(sql[i] != '\'') { continue; }
+                if(i + 1 < sql.length() && sql[i + 1] == '\'') { ++i; continue; }
+                break;
+            }
+            shape += '?';
+        }
+        else if(std::isdigit(static_cast<unsigned char>(c)) && (shape.empty() || !is_identifier(shape.back())))
+        {
+            while(i + 1 < sql.length() && (std::isdigit(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '.'))
+            {
+                ++i;
+            }
+            shape += '?';
+        }
+        else if(std::isspace(static_cast<unsigned char>(c)))
+        {
+            if(!shape.empty() && shape.back() != ' ') { shape += ' '; }
+        }
+        else
+        {
+            shape += c;
+        }
+    }
+    if(shape.length() >= max_shape_length) { shape += "..."; }
+
+    while(!shape.empty() && shape.back() == ' ') { shape.pop_back(); }
+
+    return shape;
+}
+
+void Query_Metrics::record(const std::string& sql, Duration elapsed, unsigned long rows, bool ok)
+{
+    Query_Stats& stats = table[normalize(sql)];
+
+    ++stats.calls;
+    stats.rows += rows;
+    stats.errors += (ok) ? 0 : 1;
+    stats.latency.record(elapsed);
+}
+
+void Query_Metrics::log_slow_query(const std::string& sql, Duration elapsed, const std::string& plan)
+{
+    if(slow_queries.size() >= max_slow_log_size) { slow_queries.pop_front(); }
+
+    slow_queries.push_back({ sql, elapsed, plan });
+}
+
+std::string Query_Metrics::report() const
+{
+    std::stringstream stream;
+
+    stream << std::setw(8)  << "calls"
+           << std::setw(10) << "rows"
+           << std::setw(8)  << "errors"
+           << std::setw(12) << "mean(us)"
+           << std::setw(12) << "p50(us)"
+           << std::setw(12) << "p99(us)"
+           << std::setw(12) << "max(us)"
+           << "  query\n";
+
+    for(const auto& entry : table)
+    {
+        const Query_Stats& stats = entry.second;
+        stream << std::setw(8)  << stats.calls
+               << std::setw(10) << stats.rows
+               << std::setw(8)  << stats.errors
+               << std::setw(12) << stats.latency.mean().count()
+               << std::setw(12) << stats.latency.percentile(50).count()
+               << std::setw(12) << stats.latency.percentile(99).count()
+               << std::setw(12) << stats.latency.max().count()
+               << "  " << entry.first << '\n';
+    }
+
+    for(const auto& entry : malformed)
+    {
+        stream << "\nMalformed rows skipped from " << entry.first << ": " << entry.second << '\n';
+    }
+
+    stream << "\nSlow queries (>= " << threshold.count() << "us): " << slow_queries.size() << '\n';
+    for(const auto& query : slow_queries)
+    {
+        stream << "\n[" << query.elapsed.count() << "us] " << query.sql << '\n'
+               << query.query_plan;
+    }
+    return stream.str();
+}
+
+void Query_Metrics::reset()
+{
+    table.clear();
+    slow_queries.clear();
+    malformed.clear();
+}
@@ -0,0 +1,253 @@
+/*
+
+File: record_codec.cpp
+
+Brief: Record Codec implementation
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <array>
+#include <cstdio>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <filesystem>
+#include <ChocAn/data/record_codec.hpp>
+#include <ChocAn/core/entities/account.hpp>
+#include <ChocAn/core/entities/service.hpp>
+#include <ChocAn/core/entities/transaction.hpp>
+
+namespace
+{
+    Record_Codec::Data_Table prefixed(const Record_Codec::Data_Table& table, const std::string& prefix)
+    {
+        Record_Codec::Data_Table sub_table;
+        for(auto it = table.lower_bound(prefix); it != table.end() && it->first.compare(0, prefix.length(), prefix) == 0; ++it)
+        {
+            sub_table.emplace(it->first.substr(prefix.length()), it->second);
+        }
+        return sub_table;
+    }
+
+    // Service::serialize rounds costs to 5 significant digits
+    Record_Codec::Data_Table service_table(const Service& service)
+    {
+        return { { "code", std::to_string(service.code())       }
+               , { "cost", std::to_string(service.cost().value) }
+               , { "name", service.name()                       } };
+    }
+}
+
+std::string Record_Codec::frame(Record_Type type, const std::string& payload)
+{
+    std::string record;
+    record.reserve(header_size + payload.length());
+
+    put_u32(record, payload.length());
+    put_u32(record, 0);
+    record += static_cast<char>(type);
+    record += payload;
+
+    uint32_t crc = crc32(record.data() + 8, payload.length() + 1);
+    for(int i = 0; i < 4; ++i) { record[4 + i] = static_cast<char>((crc >> (8 * i)) & 0xFF); }
+
+    return record;
+}
+
+std::string Record_Codec::encode(const Data_Table& table)
+{
+    std::string payload;
+    for(const auto& field : table)
+    {
+        put_u32(payload, field.first.length());
+        payload += field.first;
+        put_u32(payload, field.second.length());
+        payload += field.second;
+    }
+    return payload;
+}
+
+Result<Record_Codec::Data_Table> Record_Codec::decode(const std::string& payload)
+{
+    Data_Table table;
+
+    size_t offset = 0;
+    auto next = [&](std::string& field)
+    {
+        if(offset + 4 > payload.length()) { return false; }
+
+        uint32_t length = get_u32(payload, offset);
+        if(offset + 4 + length > payload.length()) { return false; }
+
+        field = payload.substr(offset + 4, length);
+        offset += 4 + length;
+        return true;
+    };
+    while(offset < payload.length())
+    {
+        std::string key, value;
+        if(!next(key) || !next(value)) { return Error_Code::Malformed_Row; }
+
+        table.insert_or_assign(std::move(key), std::move(value));
+    }
+    return table;
+}
+
+std::string Record_Codec::encode(const Account& account)
+{
+    return encode(account.serialize());
+}
+
+std::string Record_Codec::encode(const Service& service)
+{
+    return encode(service_table(service));
+}
+
+std::string Record_Codec::encode(const Transaction& transaction)
+{
+    Data_Table data { { "service_date", std::to_string(transaction.service_date().unix_timestamp()) }
+                    , { "filed_date",   std::to_string(transaction.filed_date().unix_timestamp())   }
+                    , { "comments",     transaction.comments()                                      } };
+
+    for(const auto& field : service_table(transaction.service()))
+    {
+        data.emplace("service." + field.first, field.second);
+    }
+    for(const auto& field : transaction.provider().serialize())
+    {
+        data.emplace("provider." + field.first, field.second);
+    }
+    for(const auto& field : transaction.member().serialize())
+    {
+        data.emplace("member." + field.first, field.second);
+    }
+    return encode(data);
+}
+
+Result<Account> Record_Codec::decode_account(const std::string& payload, const Key<Data_Gateway>& key)
+{
+    Result<Data_Table> data = decode(payload);
+    return (data) ? Account::decode(data.value(), key) : data.error();
+}
+
+Result<Service> Record_Codec::decode_service(const std::string& payload, const Key<Data_Gateway>& key)
+{
+    Result<Data_Table> data = decode(payload);
+    return (data) ? Service::decode(data.value(), key) : data.error();
+}
+
+Result<Transaction> Record_Codec::decode_transaction(const std::string& payload, const Key<Data_Gateway>& key)
+{
+    Result<Data_Table> data = decode(payload);
+    if(!data) { return data.error(); }
+
+    Result<Account> provider = Account::decode(prefixed(data.value(), "provider."), key);
+    Result<Account> member   = Account::decode(prefixed(data.value(), "member."), key);
+    Result<Service> service  = Service::decode(prefixed(data.value(), "service."), key);
+
+    auto service_date = data->find("service_date");
+    auto filed_date   = data->find("filed_date");
+    auto comments     = data->find("comments");
+    if(!provider || !member || !service || service_date == data->end() || filed_date == data->end() || comments == data->end())
+    {
+        return Error_Code::Malformed_Row;
+    }
+
+    Result<long> service_time = Codecs::decode_number<long>(service_date->second);
+    Result<long> filed_time   = Codecs::decode_number<long>(filed_date->second);
+    if(!service_time || !filed_time) { return Error_Code::Malformed_Row; }
+
+    return Transaction( std::move(provider).value()
+                      , std::move(member).value()
+                      , std::move(service).value()
+                      , DateTime(service_time.value())
+                      , DateTime(filed_time.value())
+                      , comments->second
+                      , key );
+}
+
+uint32_t Record_Codec::crc32(const char* data, size_t length, uint32_t crc)
+{
+    static const std::array<uint32_t, 256> table = []()
+    {
+        std::array<uint32_t, 256> table {};
+        for(uint32_t i = 0; i < table.size(); ++i)
+        {
+            uint32_t value = i;
+            for(int bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            table[i] = value;
+        }
+        return table;
+    }();
+
+    crc = ~crc;
+    for(size_t i = 0; i < length; ++i)
+    {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool Record_Codec::write_atomic(const std::string& path, const std::string& data)
+{
+    std::string temp = path + ".tmp";
+
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) { return false; }
+
+    size_t written = 0;
+    while(written < data.length())
+    {
+        ssize_t result = ::write(fd, data.data() + written, data.length() - written);
+        if(result < 0) { break; }
+        written += result;
+    }
+    bool ok = written == data.length() && ::fsync(fd) == 0;
+    ::close(fd);
+
+    if(!ok || std::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        return false;
+    }
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    sync_directory((parent.empty()) ? "." : parent.string());
+    return true;
+}
+
+void Record_Codec::sync_directory(const std::string& directory)
+{
+    int dir = ::open(directory.c_str(), O_RDONLY);
+    if(dir >= 0)
+    {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+
+uint32_t Record_Codec::get_u32(const std::string& buffer, size_t offset)
+{
+    uint32_t value = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+void Record_Codec::put_u32(std::string& buffer, uint32_t value)
+{
+    for(int i = 0; i < 4; ++i) { buffer += static_cast<char>((value >> (8 * i)) & 0xFF); }
+}
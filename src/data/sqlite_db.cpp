@@ -15,10 +15,13 @@ https://github.com/AlexanderJDupree/ChocAn
  
 */
 
-#include <cstring>
+#include <cctype>
+#include <chrono>
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <functional>
+#include <string_view>
 #include <ChocAn/data/sqlite_db.hpp>
 #include <ChocAn/core/utils/exception.hpp>
 #include <ChocAn/core/utils/overloaded.hpp>
@@ -32,6 +35,16 @@ SQLite_DB::SQLite_DB(const char* db_name)
     {
         throw chocan_db_exception("Fatal: Unable to connect to DB", {});
     }
+    // INSERT OR REPLACE only fires delete triggers, which keep accounts_fts in sync, when enabled
+    sqlite3_exec(db, "PRAGMA recursive_triggers = ON;", nullptr, nullptr, nullptr);
+
+    // Other connections to the same file hold its lock briefly, wait for it instead of failing
+    sqlite3_busy_timeout(db, busy_timeout_ms);
+
+    if(!migrate())
+    {
+        throw chocan_db_exception("Fatal: Unable to migrate DB", { { "error", last_err } });
+    }
 }
 SQLite_DB::SQLite_DB(const char* db_name, const char* schema_file)
     : SQLite_DB(db_name)
@@ -57,22 +70,239 @@ bool SQLite_DB::load_schema(const char* schema_file)
 
         buffer << schema.rdbuf();
 
-        return execute_statement(buffer.str(), no_callback);
+        // Stamps the schema version on a database the schema just created
+        return execute_statement(buffer.str(), no_callback) && migrate();
     }
     return false;
 }
 
+bool SQLite_DB::migrate()
+{
+    std::vector<SQL_Row> stamp = select_rows("PRAGMA user_version;");
+    Result<int> version = Codecs::decode_number<int>((stamp.empty()) ? "" : stamp.front()["user_version"]);
+    if(version && version.value() >= schema_version) { return true; }
+
+    // Without a transactions table there is no schema yet, load_schema stamps it once loaded
+    std::vector<SQL_Row> columns = select_rows("PRAGMA table_info(transactions);");
+    if(columns.empty()) { return true; }
+
+    bool keyed = std::any_of(columns.begin(), columns.end(), [](SQL_Row& column) { return column["name"] == "transaction_id"; });
+    if(keyed) { return execute_statement("PRAGMA user_version = " + std::to_string(schema_version) + ';', no_callback); }
+
+    // Partitions were created from the old table, each would need its own rebuild
+    if(is_partitioned())
+    {
+        last_err = "partitioned transactions predate transaction IDs, migrate them with the sqlite3 shell";
+        return false;
+    }
+
+    // Version 1 keys transactions by transaction_id, filed_date was the key before. Rows keep
+    // their service date order, so their IDs follow it
+    bool ok = execute_statement("BEGIN IMMEDIATE;", no_callback);
+    if(!ok) { return false; }
+
+    ok = execute_statement("ALTER TABLE transactions RENAME TO transactions_v0;", no_callback)
+      && execute_statement( "CREATE TABLE transactions ("
+                            " transaction_id INTEGER PRIMARY KEY AUTOINCREMENT,"
+                            " service_date INTEGER NOT NULL,"
+                            " filed_date INTEGER NOT NULL,"
+                            " provider_id INTEGER NOT NULL,"
+                            " member_id INTEGER NOT NULL,"
+                            " service_code INTEGER NOT NULL,"
+                            " comments TEXT,"
+                            " UNIQUE (filed_date, service_date, provider_id, member_id, service_code),"
+                            " FOREIGN KEY (service_code) REFERENCES services (code),"
+                            " FOREIGN KEY (provider_id) REFERENCES accounts (chocan_id),"
+                            " FOREIGN KEY (member_id) REFERENCES accounts (chocan_id) );", no_callback )
+      && execute_statement( "INSERT INTO transactions (service_date, filed_date, provider_id, member_id, service_code, comments)"
+                            " SELECT service_date, filed_date, provider_id, member_id, service_code, comments"
+                            " FROM transactions_v0 ORDER BY service_date, filed_date;", no_callback )
+      && execute_statement("DROP TABLE transactions_v0;", no_callback)
+      && execute_statement("CREATE INDEX IF NOT EXISTS transactions_service_date ON transactions (service_date, transaction_id);", no_callback)
+      && execute_statement("PRAGMA user_version = " + std::to_string(schema_version) + ';', no_callback)
+      && execute_statement("COMMIT;", no_callback);
+
+    if(!ok)
+    {
+        std::string err = last_err;
+        execute_statement("ROLLBACK;", no_callback);
+        last_err = err;
+    }
+    return ok;
+}
+
+bool SQLite_DB::restore_from(const char* db_file)
+{
+    sqlite3* image = nullptr;
+
+    bool ok = sqlite3_open_v2(db_file, &image, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK
+           && copy_database(image, db);
+
+    if(!ok && image) { last_err = sqlite3_errmsg(image); }
+
+    sqlite3_close(image);
+
+    // The restored image has its own catalog
+    partitioned = false;
+    partitions.clear();
+
+    // Images written before the current schema version are brought up to it
+    return ok && migrate();
+}
+
+bool SQLite_DB::backup_to(const char* db_file)
+{
+    sqlite3* image = nullptr;
+
+    bool ok = sqlite3_open_v2(db_file, &image, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) == SQLITE_OK
+           && copy_database(db, image);
+
+    if(!ok && image) { last_err = sqlite3_errmsg(image); }
+
+    sqlite3_close(image);
+    return ok;
+}
+
+bool SQLite_DB::is_database_image(const char* file)
+{
+    static const char header[] = "SQLite format 3";
+
+    char buffer[sizeof(header)] = {};
+    std::ifstream image(file, std::ios::binary);
+
+    return image.read(buffer, sizeof(buffer)) && std::equal(buffer, buffer + sizeof(buffer), header);
+}
+
+bool SQLite_DB::copy_database(sqlite3* source, sqlite3* destination)
+{
+    Tracer::Span span(tracer.get(), "sqlite3_backup", "db");
+
+    // Copies pages directly, skipping the SQL parsing and b-tree inserts of replaying a dump
+    sqlite3_backup* backup = sqlite3_backup_init(destination, "main", source, "main");
+    if(!backup) { return false; }
+
+    int rc = SQLITE_OK;
+    while(rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED)
+    {
+        rc = sqlite3_backup_step(backup, -1);
+        if(rc == SQLITE_BUSY || rc == SQLITE_LOCKED) { sqlite3_sleep(10); }
+    }
+    sqlite3_backup_finish(backup);
+
+    return rc == SQLITE_DONE;
+}
+
 bool SQLite_DB::execute_statement(const std::string& sql, SQL_Callback callback, void* data)
 {
+    using namespace std::chrono;
+
+    // Wraps the callers callback so the rows returned can be counted
+    struct Row_Counter
+    {
+        SQL_Callback  callback;
+        void*         data;
+        unsigned long rows;
+        std::string   error;
+    } counter { callback, data, 0, "" };
+
+    // Exceptions must not unwind through sqlite3's C frames, a throwing callback aborts the statement
+    auto counting_callback = [](void* ctx, int argc, char** argv, char** col_name) -> int
+    {
+        Row_Counter* counter = static_cast<Row_Counter*>(ctx);
+        ++counter->rows;
+        try
+        {
+            return (counter->callback) ? counter->callback(counter->data, argc, argv, col_name) : 0;
+        }
+        catch(const std::exception& err)
+        {
+            counter->error = err.what();
+            return 1;
+        }
+    };
+
+    Tracer::Span span(tracer.get(), (tracer) ? Query_Metrics::normalize(sql) : "", "db");
+
     // TODO Refactor to use the sqlite3 prepare, step, and column interface to prevent SQL injection
-    int rc = sqlite3_exec(db, sql.c_str(), callback, data, &err_msg);
+    auto start = Query_Metrics::Clock::now();
+    int rc = sqlite3_exec(db, sql.c_str(), counting_callback, &counter, &err_msg);
+    auto elapsed = duration_cast<Query_Metrics::Duration>(Query_Metrics::Clock::now() - start);
 
     if(rc != SQLITE_OK)
     {
+        last_err = (!counter.error.empty()) ? counter.error : (err_msg) ? err_msg : sqlite3_errstr(rc);
         sqlite3_free(err_msg);
-        return false;
+        err_msg = nullptr;
     }
-    return true;
+
+    record_query(sql, elapsed, counter.rows, rc == SQLITE_OK);
+    return rc == SQLITE_OK;
+}
+
+bool SQLite_DB::step_rows(const std::string& sql, const std::function<void(sqlite3_stmt*)>& read)
+{
+    using namespace std::chrono;
+
+    Tracer::Span span(tracer.get(), (tracer) ? Query_Metrics::normalize(sql) : "", "db");
+
+    auto start = Query_Metrics::Clock::now();
+
+    unsigned long rows = 0;
+    sqlite3_stmt* stmt = nullptr;
+    int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
+    if(rc == SQLITE_OK && stmt)
+    {
+        while((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            read(stmt);
+            ++rows;
+        }
+    }
+    bool ok = rc == SQLITE_DONE;
+    if(!ok) { last_err = sqlite3_errmsg(db); }
+    sqlite3_finalize(stmt);
+
+    auto elapsed = duration_cast<Query_Metrics::Duration>(Query_Metrics::Clock::now() - start);
+
+    record_query(sql, elapsed, rows, ok);
+    return ok;
+}
+
+void SQLite_DB::record_query(const std::string& sql, Query_Metrics::Duration elapsed, unsigned long rows, bool ok)
+{
+    metrics.record(sql, elapsed, rows, ok);
+
+    if(metrics.is_slow(elapsed))
+    {
+        metrics.log_slow_query(sql, elapsed, explain_query_plan(sql));
+    }
+}
+
+std::string SQLite_DB::explain_query_plan(const std::string& sql)
+{
+    std::string plan;
+    std::map<int, unsigned> depth { { 0, 0 } };
+
+    // Only the first statement is prepared, so the tail of a script is never run
+    sqlite3_stmt* stmt = nullptr;
+    std::string explain = "EXPLAIN QUERY PLAN " + sql;
+    if(sqlite3_prepare_v2(db, explain.c_str(), -1, &stmt, nullptr) != SQLITE_OK || !stmt)
+    {
+        sqlite3_finalize(stmt);
+        return "  (query plan unavailable)\n";
+    }
+
+    while(sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        int id     = sqlite3_column_int(stmt, 0);
+        int parent = sqlite3_column_int(stmt, 1);
+        const unsigned char* detail = sqlite3_column_text(stmt, 3);
+
+        depth[id] = depth[parent] + 1;
+        plan += std::string(2 * depth[id], ' ') + ((detail) ? reinterpret_cast<const char*>(detail) : "") + '\n';
+    }
+    sqlite3_finalize(stmt);
+    return plan;
 }
 
 unsigned SQLite_DB::create_account(const Account& account)
@@ -92,7 +322,11 @@ unsigned SQLite_DB::create_account(const Account& account)
         << sqlquote(data["status"]) << ");";
     
 
-    if(execute_statement(sql.str(), no_callback)) { return account.id(); }
+    if(execute_statement(sql.str(), no_callback))
+    {
+        notify(account_change(account));
+        return account.id();
+    }
     return 0;
 }
 
@@ -106,115 +340,138 @@ bool SQLite_DB::delete_account(const unsigned ID)
 {
     std::string sql = "DELETE FROM accounts WHERE chocan_id=" + std::to_string(ID) + ';';
 
-    return execute_statement(sql, no_callback);
+    // Observers need to know if a provider left, look it up while it still exists
+    std::optional<Account_Header> header = account_header(ID);
+    bool provider = header && header->kind == Codecs::Account_Kind::Provider;
+
+    if(!execute_statement(sql, no_callback)) { return false; }
+
+    notify({ Change::Kind::Account, ID, provider });
+    return true;
 }
 
 bool SQLite_DB::id_exists(const unsigned ID) const
 {
     bool flag = false;
-    auto callback = [](void* flag, int, char** argv, char**) -> int 
-    { 
-        // If query returned 1, set flag to true
-        *static_cast<bool*>(flag) = (strcmp(argv[0], "1") == 0);
-        return 0;
-    };
 
     std::string sql = "SELECT EXISTS ( SELECT 1 FROM accounts WHERE chocan_id=" + std::to_string(ID) + ");";
 
-    const_cast<SQLite_DB&>(*this).execute_statement(sql, callback, &flag);
+    const_cast<SQLite_DB&>(*this).step_rows(sql, [&flag](sqlite3_stmt* row) { flag = sqlite3_column_int(row, 0) == 1; });
     return flag;
 }
 
 unsigned SQLite_DB::add_transaction(const Transaction& transaction)
 {
-    std::stringstream sql;
+    unsigned number = (claim_writer) ? claim_writer->submit(transaction).get() : insert_transaction(transaction);
+
+    if(number) { notify(transaction_change(transaction, number)); }
+    return number;
+}
+
+std::vector<unsigned> SQLite_DB::add_transactions(const Transactions& transactions)
+{
+    std::vector<unsigned> ids(transactions.size(), 0);
+
+    // IMMEDIATE takes the write lock up front, so the group cannot deadlock upgrading from a read lock
+    if(!execute_statement("BEGIN IMMEDIATE;", no_callback)) { return ids; }
+
+    std::transform(transactions.begin(), transactions.end(), ids.begin(), [&](const Transaction& transaction)
+    {
+        return insert_transaction(transaction);
+    } );
+
+    if(!execute_statement("COMMIT;", no_callback))
+    {
+        execute_statement("ROLLBACK;", no_callback);
+        std::fill(ids.begin(), ids.end(), 0);
+
+        // Partitions created by the group were rolled back with it
+        partitions.clear();
+    }
+    return ids;
+}
+
+unsigned SQLite_DB::insert_transaction(const Transaction& transaction)
+{
+    static const std::string columns = "service_date, filed_date, provider_id, member_id, service_code";
+
     Transaction::Data_Table data = transaction.serialize();
 
-    sql << "INSERT INTO transactions VALUES ("
-        << data["service_date"] << ','
+    std::stringstream key;
+    key << data["service_date"] << ','
         << data["filed_date"]   << ','
         << data["provider_id"]  << ','
         << data["member_id"]    << ','
-        << data["service_code"] << ','
-        << sqlquote(data["comments"]) << ");";
+        << data["service_code"];
 
-    if(execute_statement(sql.str(), no_callback)) 
+    bool        by_partition = is_partitioned();
+    std::string sql = "INSERT INTO transactions (" + columns + ", comments) VALUES (" + key.str() + ',' + sqlquote(data["comments"]) + ");";
+    if(by_partition)
+    {
+        std::optional<Partition> partition = partition_for(transaction.service_date().unix_timestamp());
+
+        // Archived partitions are sealed as well
+        if(!partition || partition->sealed) { return 0; }
+
+        // The key table hands out the ID and rejects duplicates across every partition. Both
+        // rows are written under one savepoint, so a failed insert leaves neither behind
+        sql = "SAVEPOINT claim;"
+              " INSERT INTO transaction_keys (" + columns + ") VALUES (" + key.str() + ");"
+              " INSERT INTO transactions_" + std::to_string(partition->month)
+            + " (transaction_id, " + columns + ", comments) VALUES (last_insert_rowid()," + key.str() + ',' + sqlquote(data["comments"]) + ");"
+              " RELEASE claim;";
+    }
+
+    if(execute_statement(sql, no_callback)) 
     { 
-        // TODO having the primary key as the filed date will cause a collision
-        // if two transations are filed within the same second
-        return transaction.filed_date().unix_timestamp();
+        return static_cast<unsigned>(sqlite3_last_insert_rowid(db));
+    }
+    if(by_partition)
+    {
+        std::string err = last_err;
+        execute_statement("ROLLBACK TO claim; RELEASE claim;", no_callback);
+        last_err = err;
     }
+    // Another connection archived the partition, reread the catalog next time
+    if(last_err.rfind("no such table", 0) == 0) { partitions.clear(); }
     return 0;
 }
 
 std::optional<Service> SQLite_DB::lookup_service(const unsigned code)
 {
-    SQL_Row data;
-    auto callback = [](void* table, int argc, char** argv, char** col_name) -> int
-    {
-        SQL_Row* data = static_cast<SQL_Row*>(table);
+    std::string sql = "SELECT * FROM services WHERE code=" + std::to_string(code) + ';';
 
-        for(int i = 0; i < argc; ++i)
-        {
-            data->insert( { col_name[i], argv[i] } );
-        }
-        return 0;
-    };
+    std::vector<SQL_Row> rows = select_rows(sql);
+    if(rows.empty()) { return { }; } // Lookup failed
 
-    std::string sql = "SELECT * FROM services WHERE code=" + std::to_string(code) + ';';
+    Result<Service> service = Service::decode(rows.front(), db_key);
+    if(!service) { metrics.record_malformed("services"); }
 
-    if(execute_statement(sql, callback, &data) && !data.empty())
-    {
-        return Service(data, db_key);
-    }
-    return { }; // Lookup failed
+    return std::move(service).to_optional();
 }
 
 std::optional<Service> SQLite_DB::lookup_service(const std::string& code)
 {
-    try
-    {
-        return lookup_service(std::stoi(code));
-    }
-    catch(const std::exception&)
-    {
-        return { };
-    }
+    return find_service(code).to_optional();
 }
 
 std::optional<Account> SQLite_DB::get_account(const unsigned ID, const std::string& type)
 {
-    SQL_Row data;
-    auto callback = [](void* table, int argc, char** argv, char** col_name) -> int
-    {
-        SQL_Row* data = static_cast<SQL_Row*>(table);
-
-        for(int i = 0; i < argc; ++i)
-        {
-            data->insert( { col_name[i], argv[i] } );
-        }
-        return 0;
-    };
-
     std::string acct_type = (type == "*") ? "" : " and type=" + sqlquote(type);
     std::string sql = "SELECT * FROM accounts WHERE chocan_id=" + std::to_string(ID) + acct_type + ";";
 
-    if(execute_statement(sql, callback, &data) && !data.empty())
-    {
-        return Account(data, db_key);
-    }
-    return { };
+    std::vector<SQL_Row> rows = select_rows(sql);
+    if(rows.empty()) { return { }; }
+
+    Result<Account> account = Account::decode(rows.front(), db_key);
+    if(!account) { metrics.record_malformed("accounts"); }
+
+    return std::move(account).to_optional();
 }
 std::optional<Account> SQLite_DB::get_account(const std::string& ID, const std::string& type)
 {
-    try
-    {
-        return get_account(std::stoi(ID), type);
-    }
-    catch(const std::exception&)
-    {
-        return { };
-    }
+    Result<unsigned> key = Codecs::decode_id(ID);
+    return (key) ? get_account(key.value(), type) : std::nullopt;
 }
 std::optional<Account> SQLite_DB::get_account(const unsigned ID)
 {
@@ -261,20 +518,7 @@ Data_Gateway::Transactions SQLite_DB::get_transactions(DateTime start, DateTime
     std::vector<SQL_Row> rows = get_transaction_data(start, end, acct.id(), acct_type);
     for (const auto& row : rows)
     {
-        try
-        {
-            transactions.emplace_back( get_provider_account(row.at("provider_id")).value()
-                                        , get_member_account(row.at("member_id")).value()
-                                        , lookup_service(row.at("service_code")).value()
-                                        , DateTime(std::stoi(row.at("service_date")))
-                                        , DateTime(std::stoi(row.at("filed_date")))
-                                        , row.at("comments")
-                                        , db_key );
-        }
-        catch(const std::exception&)
-        {
-            // TODO log bad row
-        }
+        if(auto transaction = build_transaction(row)) { transactions.push_back(std::move(*transaction)); }
     }
     return transactions;
 }
@@ -284,81 +528,288 @@ Data_Gateway::Transactions SQLite_DB::get_transactions(DateTime start, DateTime
     std::vector<SQL_Row> rows = get_transaction_data(start, end);
     for (const auto& row : rows)
     {
-        try
+        if(auto transaction = build_transaction(row)) { transactions.push_back(std::move(*transaction)); }
+    }
+    return transactions;
+}
+
+Result<Transaction> SQLite_DB::build_transaction(const SQL_Row& row)
+{
+    static const std::string missing;
+    auto field = [&](const char* column) -> const std::string&
+    {
+        auto cell = row.find(column);
+        return (cell == row.end()) ? missing : cell->second;
+    };
+
+    Result<Account> provider     = find_account(field("provider_id"), Codecs::Account_Kind::Provider);
+    Result<Account> member       = find_account(field("member_id"), Codecs::Account_Kind::Member);
+    Result<Service> service      = find_service(field("service_code"));
+    Result<long>    service_date = Codecs::decode_number<long>(field("service_date"));
+    Result<long>    filed_date   = Codecs::decode_number<long>(field("filed_date"));
+
+    if(!provider || !member || !service || !service_date || !filed_date || !row.count("comments"))
+    {
+        metrics.record_malformed("transactions");
+        return Error_Code::Malformed_Row;
+    }
+    return Transaction( std::move(provider).value()
+                      , std::move(member).value()
+                      , std::move(service).value()
+                      , DateTime(service_date.value())
+                      , DateTime(filed_date.value())
+                      , field("comments")
+                      , db_key );
+}
+
+Data_Gateway::Transaction_Cursor SQLite_DB::scan_transactions(DateTime start, DateTime end, Account acct)
+{
+    std::string acct_type = std::visit( overloaded {
+        [](Member)  { return "member_id";   },
+        [](Provider){ return "provider_id"; },
+        [](Manager) { return "*"; }
+    }, acct.type());
+
+    return scan_transaction_data(start, end, acct.id(), acct_type);
+}
+Data_Gateway::Transaction_Cursor SQLite_DB::scan_transactions(DateTime start, DateTime end)
+{
+    return scan_transaction_data(start, end);
+}
+
+Data_Gateway::Transaction_Cursor SQLite_DB::scan_transaction_data(DateTime start, DateTime end, unsigned id, std::string type)
+{
+    std::string range = "service_date BETWEEN " + std::to_string(start.unix_timestamp())
+                      + " AND " + std::to_string(end.unix_timestamp())
+                      + ((type == "*") ? "" : " AND " + type + "=" + std::to_string(id));
+
+    using Key = std::pair<std::string, std::string>;
+
+    // Partitions hold disjoint months, so reading them in month order keeps the key order.
+    // Partitions created after the scan starts are not read
+    bool                   by_partition = is_partitioned();
+    std::vector<Partition> sources      = (by_partition) ? overlapping_partitions(start, end) : std::vector<Partition>();
+
+    return Transaction_Cursor([this, range, by_partition, sources, current = size_t(0), resume = std::optional<Key>()](size_t limit) mutable
+    {
+        Transactions batch;
+
+        // Bad rows are skipped, an empty batch would end the scan so keep fetching until a row is built
+        while(batch.empty() && current < ((by_partition) ? sources.size() : 1))
         {
-            transactions.emplace_back( get_provider_account(row.at("provider_id")).value()
-                                        , get_member_account(row.at("member_id")).value()
-                                        , lookup_service(row.at("service_code")).value()
-                                        , DateTime(std::stoi(row.at("service_date")))
-                                        , DateTime(std::stoi(row.at("filed_date")))
-                                        , row.at("comments")
-                                        , db_key );
+            std::optional<std::string> table = (by_partition) ? partition_source(sources[current]) : "transactions";
+            if(!table) { ++current; continue; }
+
+            // Keyset pagination seeks past the last row returned instead of using OFFSET
+            std::string after = (resume) ? " AND (service_date, transaction_id) > (" + resume->first + ", " + resume->second + ")" : "";
+            std::string sql = "SELECT * FROM " + *table + " WHERE " + range + after
+                            + " ORDER BY service_date, transaction_id LIMIT " + std::to_string(limit) + ';';
+
+            std::vector<SQL_Row> rows = select_rows(sql);
+            if(rows.empty()) { ++current; continue; }
+
+            resume.emplace(rows.back().at("service_date"), rows.back().at("transaction_id"));
+            for(const SQL_Row& row : rows)
+            {
+                if(auto transaction = build_transaction(row)) { batch.push_back(std::move(*transaction)); }
+            }
         }
-        catch(const std::exception&)
+        return batch;
+    } );
+}
+
+Data_Gateway::Transaction_Summaries SQLite_DB::transaction_summaries(DateTime start, DateTime end)
+{
+    Transaction_Summaries summaries;
+    auto read = [&summaries](sqlite3_stmt* row)
+    {
+        summaries.push_back( { static_cast<unsigned>(sqlite3_column_int64(row, 0))
+                             , static_cast<unsigned>(sqlite3_column_int64(row, 1))
+                             , static_cast<unsigned>(sqlite3_column_int64(row, 2))
+                             , static_cast<long>(sqlite3_column_int64(row, 3))
+                             , static_cast<long>(sqlite3_column_int64(row, 4))
+                             , sqlite3_column_double(row, 5) } );
+    };
+
+    // Rows whose service or accounts are gone are left out, as build_transaction leaves them out
+    auto select = [&](const std::string& table)
+    {
+        return "SELECT t.provider_id, t.member_id, t.service_code, t.service_date, t.filed_date, s.cost"
+               " FROM " + table + " AS t JOIN main.services AS s ON s.code = t.service_code"
+               " WHERE t.service_date BETWEEN " + std::to_string(start.unix_timestamp())
+             + " AND " + std::to_string(end.unix_timestamp())
+             + " AND EXISTS ( SELECT 1 FROM main.accounts WHERE chocan_id = t.provider_id AND type = 'Provider' )"
+               " AND EXISTS ( SELECT 1 FROM main.accounts WHERE chocan_id = t.member_id AND type = 'Member' )"
+               " ORDER BY t.service_date, t.transaction_id;";
+    };
+
+    if(!is_partitioned())
+    {
+        step_rows(select("transactions"), read);
+        return summaries;
+    }
+    for(const Partition& partition : overlapping_partitions(start, end))
+    {
+        if(auto table = partition_source(partition)) { step_rows(select(*table), read); }
+    }
+    return summaries;
+}
+
+namespace
+{
+
+// Reads chocan_id, type, and status columns, a row with an unknown type is skipped
+std::optional<Data_Gateway::Account_Header> read_header(sqlite3_stmt* row)
+{
+    auto text = [row](int column)
+    {
+        const unsigned char* value = sqlite3_column_text(row, column);
+        return (value) ? std::string_view(reinterpret_cast<const char*>(value), sqlite3_column_bytes(row, column))
+                       : std::string_view();
+    };
+
+    std::optional<Codecs::Account_Kind> kind = Codecs::decode_account_kind(text(1));
+    if(!kind) { return { }; }
+
+    return Data_Gateway::Account_Header { static_cast<unsigned>(sqlite3_column_int64(row, 0))
+                                        , kind.value()
+                                        , Codecs::decode_account_status(text(2)).value_or(Account_Status::Valid) };
+}
+
+} // namespace
+
+std::optional<Data_Gateway::Account_Header> SQLite_DB::account_header(const unsigned ID)
+{
+    std::optional<Account_Header> header;
+
+    step_rows( "SELECT chocan_id, type, status FROM accounts WHERE chocan_id = " + std::to_string(ID) + ';'
+             , [&header](sqlite3_stmt* row) { header = read_header(row); } );
+
+    return header;
+}
+
+Data_Gateway::Header_Cursor SQLite_DB::scan_account_headers()
+{
+    return Header_Cursor([this, last = std::optional<long>()](size_t limit) mutable
+    {
+        Header_Cursor::Batch batch;
+
+        // Bad rows are skipped, an empty batch would end the scan so keep fetching until a row is read
+        while(batch.empty())
         {
-            // TODO log bad row
+            std::string sql = "SELECT chocan_id, type, status FROM accounts WHERE chocan_id > "
+                            + std::to_string(last.value_or(-1))
+                            + " ORDER BY chocan_id LIMIT " + std::to_string(limit) + ';';
+
+            size_t rows = 0;
+            step_rows(sql, [&](sqlite3_stmt* row)
+            {
+                ++rows;
+                last = sqlite3_column_int64(row, 0);
+                if(auto header = read_header(row)) { batch.push_back(*header); }
+            } );
+            if(rows == 0) { break; }
         }
-    }
-    return transactions;
+        return batch;
+    } );
 }
 
 std::vector<SQLite_DB::SQL_Row> SQLite_DB::get_transaction_data(DateTime start, DateTime end, unsigned id, std::string type)
 {
+    std::string acct_type = (type == "*") ? "" : " AND " + type + "=" + std::to_string(id);
+    std::string range = " WHERE service_date BETWEEN "
+                      + std::to_string(start.unix_timestamp()) + " AND "
+                      + std::to_string(end.unix_timestamp())
+                      + acct_type;
+
+    if(!is_partitioned())
+    {
+        return select_rows("SELECT * FROM transactions" + range + ';');
+    }
+
     std::vector<SQL_Row> rows;
-    auto callback = [](void* list, int argc, char** argv, char** col_name) -> int
+
+    // Only partitions overlapping the range are read, one at a time so at most one archive
+    // needs to be attached per statement
+    for(const Partition& partition : overlapping_partitions(start, end))
     {
-        std::vector<SQL_Row>* rows = static_cast<std::vector<SQL_Row>*>(list);
+        if(auto table = partition_source(partition))
+        {
+            std::vector<SQL_Row> partition_rows = select_rows("SELECT * FROM " + *table + range + ';');
+            rows.insert(rows.end(), std::make_move_iterator(partition_rows.begin()), std::make_move_iterator(partition_rows.end()));
+        }
+    }
+    return rows;
+}
 
-        SQL_Row data;
-        for(int i = 0; i < argc; ++i)
+Data_Gateway::Accounts SQLite_DB::get_all_accounts(const std::string& type)
+{
+    return scan_accounts(type).drain();
+}
+
+Data_Gateway::Account_Cursor SQLite_DB::scan_accounts(const std::string& type)
+{
+    std::string acct_type = (type == "*") ? "" : " AND type=" + sqlquote(type);
+
+    return Account_Cursor([this, acct_type, last = std::optional<std::string>()](size_t limit) mutable
+    {
+        Accounts batch;
+
+        // Bad rows are skipped, an empty batch would end the scan so keep fetching until a row is built
+        while(batch.empty())
         {
-            data.insert( { col_name[i], argv[i] } );
+            std::string sql = "SELECT * FROM accounts WHERE chocan_id > " + last.value_or("-1") + acct_type
+                            + " ORDER BY chocan_id LIMIT " + std::to_string(limit) + ';';
+
+            std::vector<SQL_Row> rows = select_rows(sql);
+            if(rows.empty()) { break; }
+
+            last = rows.back().at("chocan_id");
+            for(const SQL_Row& row : rows)
+            {
+                Result<Account> account = Account::decode(row, db_key);
+                if(account) { batch.push_back(std::move(account).value()); }
+                else        { metrics.record_malformed("accounts"); }
+            }
         }
-        rows->push_back(data);
+        return batch;
+    } );
+}
 
-        return 0;
-    };
+Data_Gateway::Account_Cursor SQLite_DB::scan_member_accounts()
+{
+    return scan_accounts("Member");
+}
 
-    std::string acct_type = (type == "*") ? ";" : " AND " + type + "=" + std::to_string(id) + ";";
-    std::string sql = "SELECT * FROM transactions WHERE service_date BETWEEN "   
-                    + std::to_string(start.unix_timestamp()) + " AND "
-                    + std::to_string(end.unix_timestamp()) 
-                    + acct_type;
+Data_Gateway::Account_Cursor SQLite_DB::scan_provider_accounts()
+{
+    return scan_accounts("Provider");
+}
 
-    execute_statement(sql, callback, &rows);
-    return rows;
+Data_Gateway::Account_Cursor SQLite_DB::scan_manager_accounts()
+{
+    return scan_accounts("Manager");
 }
 
-Data_Gateway::Accounts SQLite_DB::get_all_accounts(const std::string& type)
+std::vector<SQLite_DB::SQL_Row> SQLite_DB::select_rows(const std::string& sql)
 {
     std::vector<SQL_Row> rows;
     auto callback = [](void* list, int argc, char** argv, char** col_name) -> int
     {
-        std::vector<SQL_Row>* accounts = static_cast<std::vector<SQL_Row>*>(list);
+        std::vector<SQL_Row>* rows = static_cast<std::vector<SQL_Row>*>(list);
 
         SQL_Row data;
         for(int i = 0; i < argc; ++i)
         {
-            data.insert( { col_name[i], argv[i] } );
+            data.insert( { col_name[i], (argv[i]) ? argv[i] : "" } );
         }
-        accounts->push_back(data);
+        rows->push_back(data);
 
         return 0;
     };
 
-    std::string acct_type = (type == "*") ? "" : " WHERE type=" + sqlquote(type);
-
-    std::string sql = "SELECT * FROM accounts" + acct_type;
-
-    Accounts accounts;
-    if(execute_statement(sql, callback, &rows))
-    {
-        std::for_each(rows.begin(), rows.end(), [&](const SQL_Row& row)
-        {
-            accounts.emplace_back(row, db_key);
-        } );
-    }
-    return accounts;
+    execute_statement(sql, callback, &rows);
+    return rows;
 }
 
 Data_Gateway::Accounts SQLite_DB::get_provider_accounts()
@@ -371,33 +822,381 @@ Data_Gateway::Accounts SQLite_DB::get_member_accounts()
     return get_all_accounts("Member");
 }
 
+Data_Gateway::Accounts SQLite_DB::get_manager_accounts()
+{
+    return get_all_accounts("Manager");
+}
+
+Data_Gateway::Accounts SQLite_DB::search_accounts(const std::string& query, size_t limit)
+{
+    // Each alphanumeric run becomes a quoted prefix term, the terms are implicitly AND'ed
+    std::string match;
+    for(size_t i = 0; i < query.length(); )
+    {
+        if(!std::isalnum(static_cast<unsigned char>(query[i]))) { ++i; continue; }
+
+        size_t end = i;
+        while(end < query.length() && std::isalnum(static_cast<unsigned char>(query[end]))) { ++end; }
+
+        match += ((match.empty()) ? "\"" : " \"") + query.substr(i, end - i) + "\"*";
+        i = end;
+    }
+    if(match.empty() || limit == 0) { return { }; }
+
+    // accounts_fts is kept in sync with accounts by triggers, rank orders by bm25 relevance
+    std::string sql = "SELECT accounts.* FROM accounts_fts JOIN accounts ON accounts.chocan_id = accounts_fts.rowid"
+                      " WHERE accounts_fts MATCH " + sqlquote(match) +
+                      " ORDER BY accounts_fts.rank, accounts.chocan_id LIMIT " + std::to_string(limit) + ';';
+
+    Accounts accounts;
+    for(const SQL_Row& row : select_rows(sql))
+    {
+        Result<Account> account = Account::decode(row, db_key);
+        if(account) { accounts.push_back(std::move(account).value()); }
+        else        { metrics.record_malformed("accounts"); }
+    }
+    return accounts;
+}
+
 Data_Gateway::Service_Directory SQLite_DB::service_directory()
 {
     Service_Directory directory;
+    for(const SQL_Row& row : select_rows("SELECT code, cost, name FROM services;"))
+    {
+        Result<Service> service = Service::decode(row, db_key);
+        if(service) { directory.insert( { service->code(), std::move(service).value() } ); }
+        else        { metrics.record_malformed("services"); }
+    }
+    return directory;
+}
+
+unsigned long SQLite_DB::services_version()
+{
+    unsigned long version = 0;
+    step_rows("SELECT version FROM catalog_version;", [&version](sqlite3_stmt* row) { version = sqlite3_column_int64(row, 0); });
+
+    return version;
+}
+
+std::string SQLite_DB::store_id() const
+{
+    const char* file = sqlite3_db_filename(db, "main");
+
+    return (file && *file) ? std::string("sqlite:") + file : Data_Gateway::store_id();
+}
+
+unsigned long SQLite_DB::accounts_version()
+{
+    unsigned long version = 0;
+    step_rows("SELECT version FROM accounts_version;", [&version](sqlite3_stmt* row) { version = sqlite3_column_int64(row, 0); });
+
+    return version;
+}
+
+unsigned long SQLite_DB::external_version()
+{
+    unsigned long version = 0;
+    step_rows("PRAGMA data_version;", [&version](sqlite3_stmt* row) { version = sqlite3_column_int64(row, 0); });
+
+    return version;
+}
+
+bool SQLite_DB::partition_transactions()
+{
+    static const char* catalog = "CREATE TABLE IF NOT EXISTS transaction_partitions ("
+                                 " month INTEGER PRIMARY KEY,"
+                                 " first_date INTEGER NOT NULL,"
+                                 " end_date INTEGER NOT NULL,"
+                                 " sealed INTEGER NOT NULL DEFAULT 0,"
+                                 " file TEXT );";
+
+    // IDs are unique across partitions, each partition's own key would only be unique within its month
+    static const char* keys = "CREATE TABLE IF NOT EXISTS transaction_keys ("
+                              " transaction_id INTEGER PRIMARY KEY AUTOINCREMENT,"
+                              " service_date INTEGER NOT NULL,"
+                              " filed_date INTEGER NOT NULL,"
+                              " provider_id INTEGER NOT NULL,"
+                              " member_id INTEGER NOT NULL,"
+                              " service_code INTEGER NOT NULL,"
+                              " UNIQUE (filed_date, service_date, provider_id, member_id, service_code) );";
+
+    // The transactions table is the template every partition is created from
+    if(partition_ddl("main", "transactions").empty()) { return false; }
 
-    std::vector<unsigned> service_codes;
-    auto callback = [](void* codes, int, char** argv, char**) -> int
+    if(!execute_statement("BEGIN IMMEDIATE;", no_callback)) { return false; }
+
+    bool ok = execute_statement(catalog, no_callback)
+           && execute_statement(keys, no_callback)
+           && execute_statement( "INSERT INTO transaction_keys SELECT transaction_id, service_date, filed_date, provider_id, member_id, service_code"
+                                 " FROM transactions;", no_callback );
+
+    // One row per month holding transactions
+    std::vector<SQL_Row> months = select_rows("SELECT MIN(service_date) AS service_date FROM transactions"
+                                              " GROUP BY strftime('%Y%m', service_date, 'unixepoch');");
+    for(const SQL_Row& row : months)
     {
-        std::vector<unsigned>* service_codes = static_cast<std::vector<unsigned>*>(codes);
+        Result<long> date = Codecs::decode_number<long>(row.at("service_date"));
+        std::optional<Partition> partition = (ok && date) ? partition_for(date.value()) : std::nullopt;
 
-        service_codes->push_back(std::stoi(argv[0]));
+        ok = partition && !partition->sealed
+          && execute_statement( "INSERT INTO transactions_" + std::to_string(partition->month)
+                              + " SELECT * FROM transactions WHERE service_date >= " + std::to_string(partition->first_date)
+                              + " AND service_date < " + std::to_string(partition->end_date)
+                              + " ORDER BY service_date, transaction_id;", no_callback );
+    }
+    ok = ok && execute_statement("DELETE FROM transactions;", no_callback)
+            && execute_statement("COMMIT;", no_callback);
 
-        return 0;
-    };
+    if(!ok) { execute_statement("ROLLBACK;", no_callback); }
+
+    partitions.clear();
+    partitioned = ok;
+    return ok;
+}
 
-    std::string sql = "SELECT code FROM services;";
+std::vector<SQLite_DB::Partition> SQLite_DB::transaction_partitions()
+{
+    return (is_partitioned()) ? read_partitions("") : std::vector<Partition>();
+}
+
+unsigned SQLite_DB::seal_partitions(DateTime before)
+{
+    if(!is_partitioned()) { return 0; }
 
-    if (execute_statement(sql, callback, &service_codes))
+    unsigned sealed = 0;
+    for(const Partition& partition : read_partitions( "WHERE sealed = 0 AND file IS NULL AND end_date <= "
+                                                    + std::to_string(before.unix_timestamp()) ))
     {
-        std::for_each(service_codes.begin(), service_codes.end(), [&](unsigned code)
+        std::string table   = "transactions_" + std::to_string(partition.month);
+        std::string compact = table + "_compact";
+
+        // Copying the rows in key order leaves the partition without the free pages and
+        // scattered leaves of rows that were filed out of order or deleted
+        bool ok = execute_statement("BEGIN IMMEDIATE;", no_callback);
+        if(!ok) { continue; }
+
+        ok = execute_statement("DROP TABLE IF EXISTS " + compact + ';', no_callback)
+          && execute_statement(partition_ddl("main", compact), no_callback)
+          && execute_statement("INSERT INTO " + compact + " SELECT * FROM " + table + " ORDER BY service_date, transaction_id;", no_callback)
+          && execute_statement("DROP TABLE " + table + ';', no_callback)
+          && execute_statement("ALTER TABLE " + compact + " RENAME TO " + table + ';', no_callback)
+          && execute_statement("DROP INDEX IF EXISTS " + compact + "_service_date;", no_callback)
+          && execute_statement(partition_ddl("main", table), no_callback)
+          && make_read_only("main", table)
+          && execute_statement("UPDATE transaction_partitions SET sealed = 1 WHERE month = " + std::to_string(partition.month) + ';', no_callback)
+          && execute_statement("COMMIT;", no_callback);
+
+        if(!ok) { execute_statement("ROLLBACK;", no_callback); }
+
+        sealed += ok;
+    }
+    partitions.clear();
+    return sealed;
+}
+
+bool SQLite_DB::archive_partition(int month, const std::string& file)
+{
+    std::vector<Partition> found = (is_partitioned()) ? read_partitions("WHERE month = " + std::to_string(month)) : std::vector<Partition>();
+
+    // Only sealed partitions still in this database are archived, into a file that does not exist yet
+    if(found.empty() || !found.front().sealed || !found.front().file.empty() || std::ifstream(file)) { return false; }
+
+    std::string table = "transactions_" + std::to_string(month);
+
+    if(!execute_statement("ATTACH " + sqlquote(file) + " AS archive;", no_callback)) { return false; }
+
+    bool ok = execute_statement(partition_ddl("archive", "transactions"), no_callback)
+           && execute_statement("INSERT INTO archive.transactions SELECT * FROM main." + table + " ORDER BY service_date, transaction_id;", no_callback)
+           && make_read_only("archive", "transactions");
+
+    execute_statement("DETACH archive;", no_callback);
+
+    ok = ok && execute_statement("BEGIN IMMEDIATE;", no_callback);
+    if(!ok) { return false; }
+
+    ok = execute_statement("DROP TABLE " + table + ';', no_callback)
+      && execute_statement( "UPDATE transaction_partitions SET file = " + sqlquote(file)
+                          + " WHERE month = " + std::to_string(month) + ';', no_callback )
+      && execute_statement("COMMIT;", no_callback);
+
+    if(!ok) { execute_statement("ROLLBACK;", no_callback); }
+
+    partitions.clear();
+    return ok;
+}
+
+bool SQLite_DB::detach_partition(int month)
+{
+    std::vector<Partition> found = (is_partitioned()) ? read_partitions("WHERE month = " + std::to_string(month)) : std::vector<Partition>();
+    if(found.empty() || found.front().file.empty()) { return false; }
+
+    release_archive(month);
+    partitions.clear();
+
+    return execute_statement("DELETE FROM transaction_partitions WHERE month = " + std::to_string(month) + ';', no_callback);
+}
+
+bool SQLite_DB::attach_partition(const std::string& file)
+{
+    if(!is_partitioned() || !is_database_image(file.c_str())) { return false; }
+
+    if(!execute_statement("ATTACH " + sqlquote(file) + " AS archive;", no_callback)) { return false; }
+
+    std::vector<SQL_Row> span = select_rows("SELECT MIN(service_date) AS first, MAX(service_date) AS last FROM archive.transactions;");
+
+    execute_statement("DETACH archive;", no_callback);
+
+    Result<long> first = Codecs::decode_number<long>((span.empty()) ? "" : span.front()["first"]);
+    Result<long> last  = Codecs::decode_number<long>((span.empty()) ? "" : span.front()["last"]);
+
+    // An archive holds exactly one month
+    std::optional<Partition> partition = (first && last) ? month_of(first.value()) : std::nullopt;
+    if(!partition || last.value() >= partition->end_date) { return false; }
+
+    partitions.clear();
+
+    return execute_statement( "INSERT INTO transaction_partitions VALUES ("
+                            + std::to_string(partition->month) + ", "
+                            + std::to_string(partition->first_date) + ", "
+                            + std::to_string(partition->end_date) + ", 1, "
+                            + sqlquote(file) + ");", no_callback );
+}
+
+bool SQLite_DB::is_partitioned()
+{
+    if(!partitioned)
+    {
+        partitioned = !select_rows("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'transaction_partitions';").empty();
+    }
+    return partitioned;
+}
+
+std::vector<SQLite_DB::Partition> SQLite_DB::read_partitions(const std::string& where)
+{
+    std::vector<Partition> catalog;
+    for(const SQL_Row& row : select_rows("SELECT * FROM transaction_partitions " + where + " ORDER BY month;"))
+    {
+        Result<int>  month  = Codecs::decode_number<int>(row.at("month"));
+        Result<long> first  = Codecs::decode_number<long>(row.at("first_date"));
+        Result<long> end    = Codecs::decode_number<long>(row.at("end_date"));
+
+        if(month && first && end)
         {
-            if( auto maybe_service = lookup_service(code))
-            {
-                directory.insert( { code, maybe_service.value() } );
-            }
-        } );
+            catalog.push_back({ month.value(), first.value(), end.value(), row.at("sealed") == "1", row.at("file") });
+        }
+        else
+        {
+            metrics.record_malformed("transaction_partitions");
+        }
     }
-    return directory;
+    return catalog;
+}
+
+std::optional<SQLite_DB::Partition> SQLite_DB::month_of(long date)
+{
+    std::string day = std::to_string(date) + ", 'unixepoch'";
+
+    std::vector<SQL_Row> bounds = select_rows( "SELECT strftime('%Y%m', " + day + ") AS month"
+                                               ", strftime('%s', " + day + ", 'start of month') AS first_date"
+                                               ", strftime('%s', " + day + ", 'start of month', '+1 month') AS end_date;" );
+    if(bounds.empty()) { return { }; }
+
+    Result<int>  month = Codecs::decode_number<int>(bounds.front()["month"]);
+    Result<long> first = Codecs::decode_number<long>(bounds.front()["first_date"]);
+    Result<long> end   = Codecs::decode_number<long>(bounds.front()["end_date"]);
+    if(!month || !first || !end) { return { }; }
+
+    return Partition { month.value(), first.value(), end.value(), false, "" };
+}
+
+std::optional<SQLite_DB::Partition> SQLite_DB::partition_for(long service_date)
+{
+    auto cached = partitions.upper_bound(service_date);
+    if(cached != partitions.begin() && service_date < std::prev(cached)->second.end_date)
+    {
+        return std::prev(cached)->second;
+    }
+
+    std::optional<Partition> partition = month_of(service_date);
+    if(!partition) { return { }; }
+
+    std::string month = std::to_string(partition->month);
+
+    // The month may already be cataloged by another connection, or archived. Creating it takes
+    // the write lock, so only months missing from the catalog are created
+    std::vector<Partition> found = read_partitions("WHERE month = " + month);
+    if(found.empty())
+    {
+        bool ok = execute_statement(partition_ddl("main", "transactions_" + month), no_callback)
+               && execute_statement( "INSERT OR IGNORE INTO transaction_partitions (month, first_date, end_date) VALUES ("
+                                   + month + ", " + std::to_string(partition->first_date) + ", "
+                                   + std::to_string(partition->end_date) + ");", no_callback );
+
+        found = (ok) ? read_partitions("WHERE month = " + month) : std::vector<Partition>();
+        if(found.empty()) { return { }; }
+    }
+
+    partitions.insert_or_assign(found.front().first_date, found.front());
+    return found.front();
+}
+
+std::optional<std::string> SQLite_DB::partition_source(const Partition& partition)
+{
+    if(partition.file.empty()) { return "transactions_" + std::to_string(partition.month); }
+
+    std::string alias = "partition_" + std::to_string(partition.month);
+    if(std::find(attached.begin(), attached.end(), partition.month) == attached.end())
+    {
+        // SQLite caps how many databases a connection may attach, let the oldest go first
+        if(attached.size() + 1 >= static_cast<size_t>(sqlite3_limit(db, SQLITE_LIMIT_ATTACHED, -1)))
+        {
+            release_archive(attached.front());
+        }
+        if(!execute_statement("ATTACH " + sqlquote(partition.file) + " AS " + alias + ';', no_callback))
+        {
+            return { };
+        }
+        attached.push_back(partition.month);
+    }
+    return alias + ".transactions";
+}
+
+std::vector<SQLite_DB::Partition> SQLite_DB::overlapping_partitions(DateTime start, DateTime end)
+{
+    return read_partitions( "WHERE first_date <= " + std::to_string(end.unix_timestamp())
+                          + " AND end_date > " + std::to_string(start.unix_timestamp()) );
+}
+
+std::string SQLite_DB::partition_ddl(const std::string& schema, const std::string& table)
+{
+    std::vector<SQL_Row> rows = select_rows("SELECT sql FROM main.sqlite_master WHERE type = 'table' AND name = 'transactions';");
+
+    size_t columns = (rows.empty()) ? std::string::npos : rows.front()["sql"].find('(');
+    if(columns == std::string::npos) { return ""; }
+
+    return "CREATE TABLE IF NOT EXISTS " + schema + '.' + table + ' ' + rows.front()["sql"].substr(columns) + ";\n"
+         + "CREATE INDEX IF NOT EXISTS " + schema + '.' + table + "_service_date ON " + table + " (service_date, transaction_id);";
+}
+
+bool SQLite_DB::make_read_only(const std::string& schema, const std::string& table)
+{
+    std::string sql;
+    for(const char* event : { "INSERT", "UPDATE", "DELETE" })
+    {
+        sql += "CREATE TRIGGER IF NOT EXISTS " + schema + '.' + table + "_sealed_" + event
+             + " BEFORE " + event + " ON " + table
+             + " BEGIN SELECT RAISE(ABORT, 'transaction partition is sealed'); END;\n";
+    }
+    return execute_statement(sql, no_callback);
+}
+
+void SQLite_DB::release_archive(int month)
+{
+    auto archive = std::find(attached.begin(), attached.end(), month);
+    if(archive == attached.end()) { return; }
+
+    execute_statement("DETACH partition_" + std::to_string(month) + ';', no_callback);
+    attached.erase(archive);
 }
 
 std::string SQLite_DB::sqlquote(const std::string& str) const
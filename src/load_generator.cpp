@@ -0,0 +1,338 @@
+/*
+
+File: load_generator.cpp
+
+Brief: Runs simulated provider and manager sessions concurrently against one
+       database and reports throughput and latency per state transition. Each
+       session drives a real State Controller over its own database connection,
+       the way separate terminals would.
+
+Authors: Daniel Mendez
+         Alexander Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <clara.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/app/state_controller.hpp>
+#include <ChocAn/app/null_state_viewer.hpp>
+#include <ChocAn/app/session_scheduler.hpp>
+#include <ChocAn/app/transition_metrics.hpp>
+#include <ChocAn/app/scripted_input_controller.hpp>
+#include <ChocAn/core/entities/service.hpp>
+#include <ChocAn/core/utils/parsers.hpp>
+
+using Clock  = std::chrono::steady_clock;
+using Script = Scripted_Input_Controller::Script;
+
+struct Load_Options
+{
+    std::string db_file     = "load_test.db";
+    std::string seed_file   = "chocan.db";
+    unsigned    providers   = 4;
+    unsigned    managers    = 1;
+    unsigned    seconds     = 10;
+    unsigned    iterations  = 0;
+    unsigned    rng_seed    = 1;
+    unsigned    group_us    = 0;
+    unsigned    fibers      = 0;
+    bool        partition   = false;
+    std::string mix         = "login=1,validate=4,claim=4,report=1";
+};
+
+// Relative weight of each scripted operation
+struct Workload_Mix
+{
+    unsigned login    = 1;
+    unsigned validate = 4;
+    unsigned claim    = 4;
+    unsigned report   = 1;
+};
+
+// IDs the scripts draw from, read once from the database
+struct Fixtures
+{
+    std::vector<unsigned> providers;
+    std::vector<unsigned> managers;
+    std::vector<unsigned> members;
+    std::vector<unsigned> services;
+};
+
+struct Session_Result
+{
+    Transition_Metrics transitions;
+    unsigned long long scripts = 0;
+    std::string        error   = "";
+};
+
+std::optional<Workload_Mix> parse_mix(const std::string& mix);
+
+Fixtures load_fixtures(SQLite_DB& db);
+
+void run_session(const Load_Options& options, const Workload_Mix& mix, const Fixtures& fixtures, Claim_Writer::Writer_Ptr writer,
+                 bool is_manager, unsigned session, Clock::time_point deadline, Session_Result& result);
+
+int main(int argc, char** argv)
+{
+    using namespace clara;
+
+    Load_Options options;
+    bool show_help = false;
+
+    auto cli = Help(show_help)
+             | Opt(options.db_file, "Database File")
+               ["--db"]("Database the sessions run against, overwritten by --seed first. Defaults to load_test.db")
+             | Opt(options.seed_file, "Seed File")
+               ["--seed"]("Database copied into --db before the run, defaults to chocan.db")
+             | Opt(options.providers, "count")
+               ["--providers"]("Concurrent provider sessions, defaults to 4")
+             | Opt(options.managers, "count")
+               ["--managers"]("Concurrent manager sessions, defaults to 1")
+             | Opt(options.seconds, "seconds")
+               ["--seconds"]("How long each session runs, defaults to 10")
+             | Opt(options.iterations, "count")
+               ["--iterations"]("Stop each session after this many scripts instead of after --seconds")
+             | Opt(options.mix, "weights")
+               ["--mix"]("Weights of each operation, defaults to login=1,validate=4,claim=4,report=1")
+             | Opt(options.group_us, "microseconds")
+               ["--group-commit"]("Commit claims through one writer, grouping those filed within this window")
+             | Opt(options.fibers, "threads")
+               ["--fibers"]("Run the sessions as fibers over this many threads instead of a thread each")
+             | Opt(options.partition)
+               ["--partition"]("Store the copy's transactions in monthly partitions before the run")
+             | Opt(options.rng_seed, "seed")
+               ["--rng-seed"]("Seed for the operation and ID choices, so runs are repeatable");
+
+    auto parsed = cli.parse( { argc, argv } );
+    std::optional<Workload_Mix> mix = parse_mix(options.mix);
+    if(!parsed || show_help || !mix || options.providers + options.managers == 0)
+    {
+        std::cerr << cli << std::endl;
+        return 1;
+    }
+
+    Fixtures fixtures;
+    {
+        SQLite_DB seed(options.seed_file.c_str());
+        if(!seed.backup_to(options.db_file.c_str()))
+        {
+            std::cerr << "Unable to copy " << options.seed_file << " to " << options.db_file << '\n';
+            return 1;
+        }
+        fixtures = load_fixtures(seed);
+    }
+    if(options.partition && !SQLite_DB(options.db_file.c_str()).partition_transactions())
+    {
+        std::cerr << "Unable to partition the transactions of " << options.db_file << '\n';
+        return 1;
+    }
+    if(fixtures.providers.empty() || fixtures.members.empty() || fixtures.services.empty()
+       || (options.managers && fixtures.managers.empty()))
+    {
+        std::cerr << options.seed_file << " needs providers, members, services, and managers to run sessions\n";
+        return 1;
+    }
+
+    // The writer has its own connection, sessions hand their claims to it
+    Claim_Writer::Writer_Ptr writer;
+    if(options.group_us)
+    {
+        writer = std::make_shared<Claim_Writer>( std::make_shared<SQLite_DB>(options.db_file.c_str())
+                                               , Claim_Writer::Duration(options.group_us) );
+    }
+
+    unsigned sessions = options.providers + options.managers;
+    std::vector<Session_Result> results(sessions);
+    std::vector<std::thread>    threads;
+
+    Clock::time_point start    = Clock::now();
+    Clock::time_point deadline = start + std::chrono::seconds(options.seconds);
+
+    if(options.fibers)
+    {
+        Session_Scheduler scheduler(options.fibers);
+        for(unsigned session = 0; session < sessions; ++session)
+        {
+            scheduler.spawn([&, session]()
+            {
+                run_session(options, *mix, fixtures, writer, session >= options.providers, session, deadline, results[session]);
+            } );
+        }
+        scheduler.wait();
+    }
+    else
+    {
+        for(unsigned session = 0; session < sessions; ++session)
+        {
+            threads.emplace_back(run_session, std::cref(options), std::cref(*mix), std::cref(fixtures), writer,
+                                 session >= options.providers, session, deadline, std::ref(results[session]));
+        }
+        for(std::thread& thread : threads) { thread.join(); }
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Transition_Metrics transitions;
+    unsigned long long scripts = 0;
+    for(unsigned session = 0; session < sessions; ++session)
+    {
+        transitions.merge(results[session].transitions);
+        scripts += results[session].scripts;
+
+        if(!results[session].error.empty())
+        {
+            std::cerr << "Session " << session << " failed: " << results[session].error << '\n';
+        }
+    }
+
+    std::cout << options.providers << " provider and " << options.managers << " manager sessions against "
+              << options.db_file << " for " << std::fixed << std::setprecision(2) << elapsed << "s\n"
+              << "  " << scripts << " operations, " << scripts / elapsed << " operations/s\n"
+              << "  " << transitions.count() << " transitions, " << transitions.count() / elapsed << " transitions/s\n\n"
+              << transitions.report();
+
+    if(writer)
+    {
+        Claim_Writer::Stats stats = writer->stats();
+        std::cout << "\nGroup commit: " << stats.claims << " claims in " << stats.commits << " commits, "
+                  << "largest group " << stats.largest << '\n';
+    }
+
+    return 0;
+}
+
+std::optional<Workload_Mix> parse_mix(const std::string& mix)
+{
+    Workload_Mix weights { 0, 0, 0, 0 };
+
+    for(const std::string& entry : Parsers::split(mix, ","))
+    {
+        std::vector<std::string> pair = Parsers::split(entry, "=");
+        Result<unsigned> weight = Codecs::decode_id((pair.size() == 2) ? pair[1] : "");
+        if(!weight) { return { }; }
+
+        if     (pair[0] == "login")    { weights.login    = weight.value(); }
+        else if(pair[0] == "validate") { weights.validate = weight.value(); }
+        else if(pair[0] == "claim")    { weights.claim    = weight.value(); }
+        else if(pair[0] == "report")   { weights.report   = weight.value(); }
+        else { return { }; }
+    }
+    if(weights.login + weights.validate + weights.claim + weights.report == 0) { return { }; }
+
+    return weights;
+}
+
+Fixtures load_fixtures(SQLite_DB& db)
+{
+    Fixtures fixtures;
+
+    for(const Account& account : db.scan_provider_accounts()) { fixtures.providers.push_back(account.id()); }
+    for(const Account& account : db.scan_manager_accounts())  { fixtures.managers.push_back(account.id()); }
+    for(const Account& account : db.scan_member_accounts())
+    {
+        // Claims against suspended members are rejected, leave them out so every claim files
+        if(std::get<Member>(account.type()).status() == Account_Status::Valid)
+        {
+            fixtures.members.push_back(account.id());
+        }
+    }
+    for(const auto& service : db.service_directory()) { fixtures.services.push_back(service.first); }
+
+    return fixtures;
+}
+
+// Every script starts and ends on the session's menu
+Script next_script(const Workload_Mix& mix, const Fixtures& fixtures, bool is_manager, std::mt19937& rng)
+{
+    auto pick = [&](const std::vector<unsigned>& ids)
+    {
+        return std::to_string(ids[std::uniform_int_distribution<size_t>(0, ids.size() - 1)(rng)]);
+    };
+
+    // Managers neither validate members nor file claims
+    std::discrete_distribution<int> operation({ double(mix.login)
+                                              , double((is_manager) ? 0 : mix.validate)
+                                              , double((is_manager) ? 0 : mix.claim)
+                                              , double((is_manager) ? mix.report : 0) });
+    switch (operation(rng))
+    {
+    case 0: // Log out and back in
+        return { "0", pick((is_manager) ? fixtures.managers : fixtures.providers) };
+    case 1: // Look up a member and leave the account view
+        return { "4", pick(fixtures.members), "" };
+    case 2:
+    {
+        DateTime today = DateTime::get_current_datetime();
+        std::stringstream date;
+        date << std::setfill('0') << std::setw(2) << today.month().count() << '-'
+             << std::setw(2) << today.day().count() << '-' << today.year().count();
+
+        return { "5", pick(fixtures.members), date.str(), pick(fixtures.services), "Load test claim", "y" };
+    }
+    default: // Summary report over every transaction
+        return { "4", "all", "" };
+    }
+}
+
+void run_session(const Load_Options& options, const Workload_Mix& mix, const Fixtures& fixtures, Claim_Writer::Writer_Ptr writer,
+                 bool is_manager, unsigned session, Clock::time_point deadline, Session_Result& result)
+{
+    try
+    {
+        std::mt19937 rng(options.rng_seed + session);
+
+        // Logging in is the first script, every later script is drawn from the mix
+        bool logged_in = false;
+        auto input = std::make_shared<Scripted_Input_Controller>([&]() -> Script
+        {
+            if(!logged_in)
+            {
+                logged_in = true;
+                std::vector<unsigned> ids = (is_manager) ? fixtures.managers : fixtures.providers;
+                return { std::to_string(ids[session % ids.size()]) };
+            }
+            // Lets the other sessions sharing this thread run, a no-op with a thread per session
+            Session_Scheduler::yield();
+
+            bool done = (options.iterations) ? result.scripts >= options.iterations : Clock::now() >= deadline;
+            if(done) { return { }; }
+
+            ++result.scripts;
+            return next_script(mix, fixtures, is_manager, rng);
+        } );
+
+        auto db = std::make_shared<SQLite_DB>(options.db_file.c_str());
+        db->set_claim_writer(writer);
+
+        State_Controller controller( std::make_shared<ChocAn>(db)
+                                   , std::make_shared<Null_State_Viewer>()
+                                   , input );
+
+        while(!controller.end_state())
+        {
+            const char* from  = State_Controller::state_name(controller.current_state());
+            auto        begin = Clock::now();
+
+            controller.interact();
+
+            result.transitions.record( from, State_Controller::state_name(controller.current_state())
+                                     , std::chrono::duration_cast<Transition_Metrics::Duration>(Clock::now() - begin) );
+        }
+    }
+    catch(const std::exception& err)
+    {
+        result.error = err.what();
+    }
+}
@@ -20,39 +20,87 @@ https://github.com/AlexanderJDupree/LinkedListsCPP
 #define CHOCAN_VERSION_PATCH 0
 
 #include <fstream>
+#include <iostream>
 #include <clara.hpp>
-#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/log_db.hpp>
+#include <ChocAn/data/memory_db.hpp>
 #include <ChocAn/data/sqlite_db.hpp>
 #include <ChocAn/app/state_controller.hpp>
+#include <ChocAn/app/null_state_viewer.hpp>
+#include <ChocAn/app/transition_metrics.hpp>
+#include <ChocAn/app/replay_input_controller.hpp>
+#include <ChocAn/core/utils/exception.hpp>
 #include <ChocAn/view/terminal_state_viewer.hpp>
 #include <ChocAn/view/terminal_input_controller.hpp>
 
-int run(std::istream& in_stream, std::ostream& out_stream, bool in_memory, bool compact);
+struct Run_Options
+{
+    bool        in_memory         = false;
+    bool        compact           = false;
+    bool        db_stats          = false;
+    unsigned    slow_query_ms     = 100;
+    std::string trace_file        = "";
+    std::string log_dir           = "";
+    std::string log_sync          = "batch";
+    std::string seed_file         = "";
+    std::string snapshot_file     = "";
+    unsigned    snapshot_interval = 0;
+    std::string record_file       = "";
+    std::string replay_file       = "";
+    bool        replay_fast       = false;
+};
+
+int run(std::istream& in_stream, std::ostream& out_stream, const Run_Options& options);
+
+Data_Gateway::Database_Ptr open_database(const Run_Options& options, std::shared_ptr<SQLite_DB>& sqlite);
+
+std::optional<Log_DB::Sync_Policy> log_sync_policy(const std::string& name);
 
 int main (int argc, char ** argv) 
 {
     using namespace clara;
 
+    Run_Options options;
+
 #ifdef DEBUG
-    bool in_memory = true;
-#else
-    bool in_memory = false;
+    options.in_memory = true;
 #endif
 
     bool show_help = false;
-    bool compact   = false;
     std::string input_file = "";
 
     auto cli = Help(show_help)
              | Opt(input_file, "Input File")
                ["-i"]["--input-file"]("Location of input, defaults to STDIN")
-             | Opt(compact)
+             | Opt(options.compact)
                ["-c"]["--compact-output"]("Don't clear screen with newlines on each iteration")
-             | Opt(in_memory)
-               ["-m"]["--in-memory"]("Run the database in memory, defaults to false for Release build");
+             | Opt(options.in_memory)
+               ["-m"]["--in-memory"]("Run the database in memory, defaults to false for Release build")
+             | Opt(options.db_stats)
+               ["--db-stats"]("Print per query database stats and the slow query log on exit, sessions must be served by SQLite")
+             | Opt(options.slow_query_ms, "milliseconds")
+               ["--slow-query-ms"]("Log queries slower than this with their query plan, defaults to 100")
+             | Opt(options.seed_file, "Seed File")
+               ["--seed"]("Start in memory from a database image or snapshot instead of the schema file")
+             | Opt(options.snapshot_file, "Snapshot File")
+               ["--snapshot"]("Snapshot the database to this file on exit, and periodically with --snapshot-interval")
+             | Opt(options.snapshot_interval, "seconds")
+               ["--snapshot-interval"]("Seconds between snapshots, checked between interactions")
+             | Opt(options.log_dir, "Log Directory")
+               ["--log-db"]("Serve from a log structured store in this directory, seeded from the database when empty")
+             | Opt(options.log_sync, "always|batch|never")
+               ["--log-sync"]("With --log-db, fdatasync after every record, every batch of records, or never, defaults to batch")
+             | Opt(options.record_file, "Session File")
+               ["--record"]("Record each line of input, when it was read, and the state that read it")
+             | Opt(options.replay_file, "Session File")
+               ["--replay"]("Replay a recorded session at its recorded pace and report per transition latency")
+             | Opt(options.replay_fast)
+               ["--replay-fast"]("With --replay, replay without pauses and without rendering")
+             | Opt(options.trace_file, "Trace File")
+               ["--trace"]("Write a Chrome trace of state transitions, input, DB and rendering to a file");
 
     auto result = cli.parse( { argc, argv } );
-    if(!result || show_help) 
+    if(!result || show_help || !log_sync_policy(options.log_sync))
     { 
         std::cerr << cli << std::endl;
         return 1;
@@ -61,27 +109,191 @@ int main (int argc, char ** argv)
     std::ifstream in_stream(input_file);
     if(in_stream.is_open())
     {
-        int exit_code = run(in_stream, std::cout, in_memory, compact);
+        int exit_code = run(in_stream, std::cout, options);
         in_stream.close();
         return exit_code;
     }
-    return run(std::cin, std::cout, in_memory, compact);
+    return run(std::cin, std::cout, options);
 }
 
-int run(std::istream& in_stream, std::ostream& out_stream, bool in_memory, bool compact)
+int run(std::istream& in_stream, std::ostream& out_stream, const Run_Options& options)
 {
-    ChocAn::Database_Ptr db = (in_memory) ? std::make_unique<SQLite_DB>(":memory:", "chocan_schema.sql")
-                                          : std::make_unique<SQLite_DB>("chocan.db");
+    std::shared_ptr<SQLite_DB> sqlite;
+
+    Data_Gateway::Database_Ptr db = open_database(options, sqlite);
+
+    // Query stats are kept by SQLite_DB, sessions served by Memory_DB or Log_DB never reach it
+    auto served_sqlite = std::dynamic_pointer_cast<SQLite_DB>(db);
+    if(options.db_stats && !served_sqlite)
+    {
+        std::cerr << "--db-stats requires sessions served by SQLite, it cannot be used with -m, --log-db, or a snapshot --seed\n";
+        return 1;
+    }
+    if(served_sqlite)
+    {
+        served_sqlite->query_metrics().set_slow_threshold(std::chrono::milliseconds(options.slow_query_ms));
+    }
+
+    std::ifstream session;
+    std::shared_ptr<Replay_Input_Controller> replay;
+    if(!options.replay_file.empty())
+    {
+        session.open(options.replay_file);
+        if(!session.is_open())
+        {
+            std::cerr << "Unable to open session " << options.replay_file << '\n';
+            return 1;
+        }
+        using Pace = Replay_Input_Controller::Pace;
+        replay = std::make_shared<Replay_Input_Controller>(session, (options.replay_fast) ? Pace::Fast : Pace::Recorded);
+    }
+
+    auto viewer = std::make_shared<Terminal_State_Viewer>(options.compact, out_stream);
 
     State_Controller controller ( std::make_unique<ChocAn>(db)
-                                , std::make_unique<Terminal_State_Viewer>(compact, out_stream)
-                                , std::make_unique<Terminal_Input_Controller>(in_stream) );
+                                , (replay && options.replay_fast) ? std::make_shared<Null_State_Viewer>()
+                                                                  : State_Viewer::State_Viewer_Ptr(viewer)
+                                , (replay) ? Input_Controller::Input_Control_Ptr(replay)
+                                           : std::make_shared<Terminal_Input_Controller>(in_stream) );
+
+    std::ofstream recording;
+    if(!options.record_file.empty())
+    {
+        recording.open(options.record_file);
+        controller.enable_recording(recording);
+    }
+
+    Tracer::Tracer_Ptr tracer = (options.trace_file.empty()) ? nullptr : std::make_shared<Tracer>();
+    if(tracer)
+    {
+        db->set_tracer(tracer);
+        viewer->set_tracer(tracer);
+        controller.enable_tracing(tracer);
+    }
+
+    // Memory_DB engines write binary snapshots, SQLite writes a database image
+    auto take_snapshot = [&]()
+    {
+        auto memory_db = std::dynamic_pointer_cast<Memory_DB>(db);
+
+        bool ok = (memory_db) ? memory_db->save_snapshot(options.snapshot_file)
+                              : sqlite->backup_to(options.snapshot_file.c_str());
+        if(!ok)
+        {
+            std::cerr << "Unable to write snapshot to " << options.snapshot_file << '\n';
+        }
+    };
+    auto last_snapshot = std::chrono::steady_clock::now();
+
+    Transition_Metrics transitions;
 
     // TODO exit loop if viewer can't open view
     while(!controller.end_state())
     {
-        controller.interact();
+        if(replay)
+        {
+            // Time spent holding input back to the recorded pace is not the application's latency
+            const char* from   = State_Controller::state_name(controller.current_state());
+            auto        waited = replay->waited();
+            auto        begin  = std::chrono::steady_clock::now();
+
+            controller.interact();
+
+            auto elapsed = std::chrono::steady_clock::now() - begin - (replay->waited() - waited);
+            transitions.record( from, State_Controller::state_name(controller.current_state())
+                              , std::chrono::duration_cast<Transition_Metrics::Duration>(elapsed) );
+        }
+        else
+        {
+            controller.interact();
+        }
+
+        if(!options.snapshot_file.empty() && options.snapshot_interval > 0
+           && std::chrono::steady_clock::now() - last_snapshot >= std::chrono::seconds(options.snapshot_interval))
+        {
+            take_snapshot();
+            last_snapshot = std::chrono::steady_clock::now();
+        }
+    }
+
+    if(!options.snapshot_file.empty())
+    {
+        take_snapshot();
+    }
+
+    if(options.db_stats)
+    {
+        std::cerr << "\n" << served_sqlite->query_metrics().report();
+    }
+
+    if(replay)
+    {
+        std::cerr << "\nReplayed " << replay->lines() << " lines of " << options.replay_file << "\n"
+                  << transitions.report();
+    }
+
+    if(tracer)
+    {
+        std::ofstream trace(options.trace_file);
+        trace << tracer->chrome_trace();
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+Data_Gateway::Database_Ptr open_database(const Run_Options& options, std::shared_ptr<SQLite_DB>& sqlite)
+{
+    Data_Gateway::Database_Ptr db;
+    if(!options.seed_file.empty())
+    {
+        const char* seed = options.seed_file.c_str();
+
+        sqlite = std::make_shared<SQLite_DB>(":memory:");
+
+        // Database images are restored page by page and served straight from memory
+        if(SQLite_DB::is_database_image(seed))
+        {
+            if(!sqlite->restore_from(seed))
+            {
+                throw chocan_db_exception("Fatal: Unable to restore database image", { { "file", seed } });
+            }
+            db = sqlite;
+        }
+        else
+        {
+            auto memory_db = std::make_shared<Memory_DB>();
+            if(!memory_db->load_snapshot(seed))
+            {
+                throw chocan_db_exception("Fatal: Unable to load snapshot", { { "file", seed } });
+            }
+            db = memory_db;
+        }
+    }
+    else if(options.in_memory)
+    {
+        // In memory sessions are served by Memory_DB, seeded with the schema's sample data
+        sqlite = std::make_shared<SQLite_DB>(":memory:", "chocan_schema.sql");
+        db = std::make_shared<Memory_DB>(*sqlite);
+    }
+    else
+    {
+        sqlite = std::make_shared<SQLite_DB>("chocan.db");
+        db = sqlite;
+    }
+    if(!options.log_dir.empty())
+    {
+        auto log_db = std::make_shared<Log_DB>(options.log_dir, log_sync_policy(options.log_sync).value());
+        if(log_db->account_count() == 0) { log_db->import(*db); }
+
+        db = log_db;
+    }
+    return db;
+}
+
+std::optional<Log_DB::Sync_Policy> log_sync_policy(const std::string& name)
+{
+    if(name == "always") { return Log_DB::Sync_Policy::Always; }
+    if(name == "batch")  { return Log_DB::Sync_Policy::Batch;  }
+    if(name == "never")  { return Log_DB::Sync_Policy::Never;  }
+    return { };
+}
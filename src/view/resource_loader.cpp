@@ -21,85 +21,116 @@ https://github.com/AlexanderJDupree/ChocAn
 
 void Resource_Loader::update()
 {
-    if ( state ) table = std::visit(*this, *state);
+    if ( !state ) { return; }
+
+    // The old table is the arena's only tenant, destroy it before the arena is reset
+    table.clear();
+    arena.release();
+
+    table = std::visit(*this, *state);
 }
 
-Resource_Loader::Resource_Table Resource_Loader::operator()(const Exit&)
+void Resource_Loader::load(const Application_State& state)
+{
+    this->state = &state;
+    update();
+}
+
+Resource_Loader::Resource_Table Resource_Loader::memoize(const std::shared_ptr<const void>& source, const std::function<Resource_Table()>& build)
 {
+    bool cached = source && !memo_source.expired()
+               && !memo_source.owner_before(source) && !source.owner_before(memo_source);
 
-    return { { "state_name", "Exit" } };
+    if(!cached)
+    {
+        memo_table  = build();
+        memo_source = source;
+    }
+    return Resource_Table(memo_table, &arena);
+}
+
+Resource_Loader::Resource_Table Resource_Loader::make_table()
+{
+    return Resource_Table(&arena);
+}
+
+Resource_Loader::Resource_Table Resource_Loader::make_table(std::map<std::string, std::string>&& entries)
+{
+    Resource_Table table(&arena);
+    for(auto& entry : entries) { table.emplace(entry.first, std::move(entry.second)); }
+    return table;
+}
+
+Resource_Loader::Resource_Table Resource_Loader::operator()(const Exit&)
+{
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Exit");
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Login& login)
 {
-    return 
-    { 
-        {"login_status", login.login_status },
-        {"state_name"  , "Login Service"    }
-    };
+    Resource_Table table = make_table();
+    table.emplace("login_status", login.login_status);
+    table.emplace("state_name"  , "Login Service");
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Provider_Menu& menu)
 {
-    return 
-    { 
-        { "state_name",  "Provider Menu" },
-        { "menu.status", menu.status     } 
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name",  "Provider Menu");
+    table.emplace("menu.status", menu.status);
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Manager_Menu& menu)
 {
-    return 
-    { 
-        { "state_name", "Manager Menu" },
-        { "menu.status", menu.status   } 
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name",  "Manager Menu");
+    table.emplace("menu.status", menu.status);
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Add_Transaction& transaction)
 {
-    return 
-    { 
-        { "state_name", "Transaction Manager" },
-
-        { "builder.user_error", render_user_error(transaction.builder->get_last_error()) },
-
-        { "builder.current_field", [&]() -> std::string
-        {
-            return std::visit( overloaded {
-                [&](const Transaction_Builder::Set_Member_Acct)  { return "Enter Member ID:"; },
-                [&](const Transaction_Builder::Set_Provider_Acct){ return "Enter Provider ID:"; },
-                [&](const Transaction_Builder::Set_Service_Date) { return "Enter service date (MM-DD-YYYY):"; },
-                [&](const Transaction_Builder::Set_Service)      { return "Enter Service Code:"; },
-                [&](const Transaction_Builder::Set_Comments)     { return "Enter comments:"; }
-            }, transaction.builder->builder_state() );
-        }() }
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Transaction Manager");
+
+    table.emplace("builder.user_error", render_user_error(transaction.builder->get_last_error()));
+
+    table.emplace("builder.current_field", std::visit( overloaded {
+        [&](const Transaction_Builder::Set_Member_Acct)  { return "Enter Member ID, or a whole claim as Member|MM-DD-YYYY|Service|Comments:"; },
+        [&](const Transaction_Builder::Set_Provider_Acct){ return "Enter Provider ID:"; },
+        [&](const Transaction_Builder::Set_Service_Date) { return "Enter service date (MM-DD-YYYY):"; },
+        [&](const Transaction_Builder::Set_Service)      { return "Enter Service Code or Name:"; },
+        [&](const Transaction_Builder::Set_Comments)     { return "Enter comments:"; }
+    }, transaction.builder->builder_state() ));
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Confirm_Transaction& state)
 {
-    Resource_Table table = state.transaction.serialize();
-    table.insert({ "state_name", "Confirm Transaction" });
+    Resource_Table table = make_table(state.transaction.serialize());
+    table.emplace("state_name", "Confirm Transaction");
     return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Find_Account& state)
 {
-    return 
-    { 
-        { "state_name", "Find Account" },
-        { "status", state.status},
-        { "string_prompt", [&](){
-            switch (state.next)
-            {
-            case Find_Account::Next::Delete_Account : return "Enter the ID of the account you wish to delete:";
-            case Find_Account::Next::Update_Account : return "Enter the ID of the account you wish to update:";
-            default: return "Enter the ID of the account you wish to view:";
-            }
-        }() }
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Find Account");
+    table.emplace("status", state.status);
+    table.emplace("matches", render_matches(state.matches));
+    table.emplace("string_prompt", [&](){
+        switch (state.next)
+        {
+        case Find_Account::Next::Delete_Account : return "Enter the ID or name of the account you wish to delete:";
+        case Find_Account::Next::Update_Account : return "Enter the ID or name of the account you wish to update:";
+        default: return "Enter the ID or name of the account you wish to view:";
+        }
+    }());
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const View_Account& state)
 {  
-    Resource_Table table = state.account.serialize();
-    table.insert({ "state_name", "View Account" });
-    table.insert({ "state_status", [&](){
+    Resource_Table table = make_table(state.account.serialize());
+    table.emplace("state_name", "View Account");
+    table.emplace("state_status", [&](){
         switch(state.status)
         {
             case View_Account::Status::Confirm_Creation : return "Is this correct? (Y/N):";
@@ -107,132 +138,159 @@ Resource_Loader::Resource_Table Resource_Loader::operator()(const View_Account&
             case View_Account::Status::Confirm_Update   : return "Update another field? (Y/N):";
             default : return "Press 'Enter' to continue:";
         };
-    }() });
+    }());
     return table;
 }
 
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Create_Account& state)
 {
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Create Account");
 
-    return 
-    {
-        {"state_name", "Create Account"},
-    
-        {"builder.status", state.builder->get_status()},
-   
-        { "builder.errors", render_user_error(state.builder->get_errors()) },
+    table.emplace("builder.status", state.builder->get_status());
 
-        { "builder.current_field", render_builder_prompt(state.builder->builder_state()) }
-    };
+    table.emplace("builder.errors", render_user_error(state.builder->get_errors()));
+
+    table.emplace("builder.current_field", render_builder_prompt(state.builder->builder_state()));
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Update_Account& state)
 {
-    return
-    {
-        {"state_name", "Update Account" },
-        
-        { "state_msg", [&]() -> std::string {
-            switch (state.status)
-            {
-            case Update_Account::Status::Update_Field : 
-                return render_user_error(state.builder->get_errors());
-            default: return state.msg;
-            }
-        }() },
-        { "state_prompt", [&]() -> std::string {
-            switch (state.status)
-            {
-            case Update_Account::Status::Choose : 
-                return "Enter 'name' or 'address' to update the corresponding field:";
-            case Update_Account::Status::Update_Field : 
-                return render_builder_prompt(state.builder->builder_state());
-            default: return {};
-            }
-        }() }
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Update Account");
+
+    table.emplace("state_msg", [&]() -> std::string {
+        switch (state.status)
+        {
+        case Update_Account::Status::Update_Field : 
+            return render_user_error(state.builder->get_errors());
+        default: return state.msg;
+        }
+    }());
+    table.emplace("state_prompt", [&]() -> std::string {
+        switch (state.status)
+        {
+        case Update_Account::Status::Choose : 
+            return "Enter 'name' or 'address' to update the corresponding field:";
+        case Update_Account::Status::Update_Field : 
+            return render_builder_prompt(state.builder->builder_state());
+        default: return {};
+        }
+    }());
+    return table;
 }
 
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Delete_Account&)
 {
-    return { };
+    return make_table();
 }
 
 Resource_Loader::Resource_Table Resource_Loader::operator()(const Generate_Report& state)
 {
-    return 
-    {
-        { "state_name", "Report Generator" },
-        { "errors", render_user_error(state.error) },
-        { "status", (state.date_range.empty()) ? "Enter report start date (" + state.date_structure + "):" 
-                                               : "Enter report end date (" + state.date_structure + "):" }
-    };
+    Resource_Table table = make_table();
+    table.emplace("state_name", "Report Generator");
+    table.emplace("errors", render_user_error(state.error));
+    table.emplace("status", (state.date_range.empty()) ? "Enter report start date (" + state.date_structure + "):" 
+                                                       : "Enter report end date (" + state.date_structure + "):");
+    return table;
 }
 Resource_Loader::Resource_Table Resource_Loader::operator()(const View_Report& state)
 {
-    return std::visit( overloaded {
-        [&](const Summary_Report& report) -> Resource_Table
-        {
-            DateTime::Data_Table start = report.start_date().serialize();
-            DateTime::Data_Table end   = report.end_date().serialize();
-            return
+    // Everything but the visible rows is independent of the page
+    Resource_Table table = memoize(state.report, [&]()
+    {
+        return std::visit( overloaded {
+            [&](const Summary_Report& report) -> Resource_Table
             {
-                { "state_name", "Summary Report" },
-                { "summary_totals"   , render_summary(report) },
-                { "provider_activity", render_provider_activity(report.activity()) },
-                { "start_date"       , start["month"] + '/' + start["day"] + '/' + start["year"] },
-                { "end_date"         , end["month"] + '/' + end["day"] + '/' + end["year"] }
-            };
+                DateTime::Data_Table start = report.start_date().serialize();
+                DateTime::Data_Table end   = report.end_date().serialize();
+
+                Resource_Table table = make_table();
+                table.emplace("state_name", "Summary Report");
+                table.emplace("summary_totals"   , render_summary(report));
+                table.emplace("start_date"       , start["month"] + '/' + start["day"] + '/' + start["year"]);
+                table.emplace("end_date"         , end["month"] + '/' + end["day"] + '/' + end["year"]);
+                return table;
+            },
+            [&](const Provider_Report& report) -> Resource_Table
+            {
+                Resource_Table table = make_table(report.account().serialize());
+                table.emplace("state_name", "Account Report");
+                table.emplace("account_totals", render_account_totals(report));
+                return table;
+            },
+            [&](const Member_Report& report) -> Resource_Table
+            {
+                Resource_Table table = make_table(report.account().serialize());
+                table.emplace("state_name", "Account Report");
+                table.emplace("account_totals", "");
+                return table;
+            }
+        }, *state.report );
+    } );
+
+    // Only the rows of the visible page are formatted
+    size_t first = state.page * View_Report::page_size;
+    size_t last  = first + View_Report::page_size;
+
+    std::visit( overloaded {
+        [&](const Summary_Report& report)
+        {
+            table["provider_activity"] = render_provider_activity(report.activity(), first, last);
         },
-        [&](const Provider_Report& report) -> Resource_Table
+        [&](const Provider_Report& report)
         {
-            Resource_Table table = report.account().serialize();
-            table.insert({ "state_name", "Account Report" });
-            table.insert({ "account_activity", render_account_activity(report) });
-            return table;
+            table["account_activity"] = render_account_activity(report, first, last);
         },
-        [&](const Member_Report& report) -> Resource_Table
+        [&](const Member_Report& report)
         {
-
-            Resource_Table table = report.account().serialize();
-            table.insert({ "state_name", "Account Report" });
-            table.insert({ "account_activity", render_account_activity(report) });
-            return table;
+            table["account_activity"] = render_account_activity(report, first, last);
         }
-    }, state.report );
+    }, *state.report );
+
+    table["page"] = render_page(state);
+    return table;
 }
 
 Resource_Loader::Resource_Table Resource_Loader::operator()(const View_Service_Directory& state)
 {
-    return
+    return memoize(state.catalog, [&]() -> Resource_Table
     {
-        { "state_name", "Service Directory" },
-        { "directory", render_directory(state.db->service_directory()) }
-    };
+        Resource_Table table = make_table();
+        table.emplace("state_name", "Service Directory");
+        table.emplace("directory", render_directory(*state.catalog));
+        return table;
+    } );
 }
 
-std::string Resource_Loader::render_directory(const Data_Gateway::Service_Directory& directory) const
+std::string Resource_Loader::render_directory(const Service_Catalog& catalog) const
 {
-    struct alphabetical_ordering
+    std::string stream;
+    const std::string bar = row_bar(3);
+    for (const auto& service : catalog.by_name())
     {
-        bool operator()(const Service& lhs, const Service& rhs) const
-        {
-            return lhs.name() < rhs.name();
-        }
-    };
+        append_cell(stream, service.name());
+        append_cell(stream, service.code());
+        append_cell(stream, '$' + service.cost().to_string());
+        stream += '|';
+        stream += bar;
+    }
+    return stream;
+}
 
-    std::set<Service, alphabetical_ordering> services;
-    std::for_each(directory.begin(), directory.end(), [&](const auto& entry)
-    {
-        services.insert(entry.second);
-    } );
+std::string Resource_Loader::render_matches(const std::vector<Account>& matches) const
+{
+    if(matches.empty()) { return ""; }
 
-    std::string stream;
-    for (const auto& service : services)
+    const std::string bar = row_bar(3);
+    std::string stream = bar + '|' + center("ChocAn ID") + '|' + center("Name") + '|' + center("City") + '|' + bar;
+    for (const Account& account : matches)
     {
-        stream += ( '|' + center(service.name()) +
-                    '|' + center(service.code()) + 
-                    '|' + center('$' + service.cost().to_string()) + 
-                    '|' + row_bar(3));
+        append_cell(stream, account.id());
+        append_cell(stream, account.name().first() + ' ' + account.name().last());
+        append_cell(stream, account.address().city() + ", " + account.address().state());
+        stream += '|';
+        stream += bar;
     }
     return stream;
 }
@@ -289,13 +347,14 @@ std::string Resource_Loader::render_user_error(const std::optional<chocan_user_e
     return stream += '\n';
 }
 
-std::string Resource_Loader::render_account_activity(const Provider_Report& report) const
+std::string Resource_Loader::render_account_activity(const Provider_Report& report, size_t first, size_t last) const
 {
     std::string activity = "Activity for this period:\n";
     
-    for ( const auto& transaction : report.transactions())
+    const auto& transactions = report.transactions();
+    for (size_t i = first; i < last && i < transactions.size(); ++i)
     {
-        Transaction::Data_Table data = transaction.serialize();
+        Transaction::Data_Table data = transactions[i].serialize();
         activity += ( "\n\nService Date: " + data["service_date_alt"] +
                       "\nFiled Date: " + data["filed_date_alt"] + 
                       "\n\tMember ID: " + data["member_id"] + 
@@ -303,19 +362,23 @@ std::string Resource_Loader::render_account_activity(const Provider_Report& repo
                       "\n\tCost: " + data["service_cost"] + 
                       "\n\tService: " + data["service_name"] + " | " + data["service_code"]);
     }
-
-    activity += "\n\nTotal Number of Consultations: " + std::to_string(report.services_rendered());
-    activity += "\nTotal Fee: " + report.total_fee().to_string();
     return activity;
 };
 
-std::string Resource_Loader::render_account_activity(const Member_Report& report) const
+std::string Resource_Loader::render_account_totals(const Provider_Report& report) const
+{
+    return "\n\nTotal Number of Consultations: " + std::to_string(report.services_rendered())
+         + "\nTotal Fee: " + report.total_fee().to_string();
+}
+
+std::string Resource_Loader::render_account_activity(const Member_Report& report, size_t first, size_t last) const
 {
     std::string activity = "Activity for this period:\n";
     
-    for ( const auto& transaction : report.transactions())
+    const auto& transactions = report.transactions();
+    for (size_t i = first; i < last && i < transactions.size(); ++i)
     {
-        Transaction::Data_Table data = transaction.serialize();
+        Transaction::Data_Table data = transactions[i].serialize();
         activity += ( "\n\nService Date: " + data["service_date_alt"] +
                       "\n\tProvider ID: " + data["provider_id"] + 
                       "\n\tProvider Name: " + data["provider_name"] + 
@@ -324,7 +387,7 @@ std::string Resource_Loader::render_account_activity(const Member_Report& report
     return activity;
 };
 
-std::string Resource_Loader::render_provider_activity(const Provider_Activity& activity) const
+std::string Resource_Loader::render_provider_activity(const Provider_Activity& activity, size_t first, size_t last) const
 {
     if(activity.empty())
     {
@@ -332,18 +395,31 @@ std::string Resource_Loader::render_provider_activity(const Provider_Activity& a
     }
 
     std::string stream;
-    for (const auto& report : activity)
+    const std::string bar = row_bar(4);
+    for (size_t i = first; i < last && i < activity.size(); ++i)
     {
-        std::string provider_name(report.account().name().last() + ", " + report.account().name().first()[0]);
-        stream += ( '|' + center(report.account().id())      +
-                    '|' + center(provider_name)              + 
-                    '|' + center(report.services_rendered()) +
-                    '|' + center('$' + report.total_fee().to_string()) + 
-                    '|' + row_bar(4));
+        const Provider_Summary& report = activity[i];
+        append_cell(stream, report.account().id());
+        append_cell(stream, report.account().name().last() + ", " + report.account().name().first()[0]);
+        append_cell(stream, report.services_rendered());
+        append_cell(stream, '$' + report.total_fee().to_string());
+        stream += '|';
+        stream += bar;
     }
     return stream;
 }
 
+std::string Resource_Loader::render_page(const View_Report& state) const
+{
+    // Reports that fit on one page are shown without paging controls
+    if(state.page_count() == 1) { return ""; }
+
+    std::string page = "Page " + std::to_string(state.page + 1) + " of " + std::to_string(state.page_count())
+                     + ", enter 'next', 'prev', or 'page N' to navigate\n";
+
+    return (state.status.empty()) ? page : page + state.status + '\n';
+}
+
 std::string Resource_Loader::render_summary(const Summary_Report& report) const
 {
     return '|' + center(report.num_providers()) +
@@ -374,6 +450,21 @@ std::string Resource_Loader::center(const std::string& str, unsigned width) cons
     return std::string(lpad, ' ') + str + std::string(rpad, ' ');
 }
 
+void Resource_Loader::append_cell(std::string& row, const std::string& str, unsigned width) const
+{
+    row += '|';
+    if (str.length() >= width) { row.append(str, 0, width); return; }
+
+    unsigned pad  = width - str.length();
+    unsigned rpad = pad / 2;
+
+    row.append(pad - rpad, ' ').append(str).append(rpad, ' ');
+}
+void Resource_Loader::append_cell(std::string& row, unsigned num, unsigned width) const
+{
+    append_cell(row, std::to_string(num), width);
+}
+
 std::string Resource_Loader::row_bar(unsigned fields) const
 {
     std::string bar("\n+");
@@ -17,6 +17,7 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 #include <ChocAn/view/terminal_state_viewer.hpp>
 
 Terminal_State_Viewer::Terminal_State_Viewer( bool compact_output
@@ -32,26 +33,40 @@ Terminal_State_Viewer::Terminal_State_Viewer( bool compact_output
         , { "clear_screen", [&](){ return clear_screen();         } }
         , { "prompt",       [&](){ return event_callback();       } }
     } )
-    , resources ({})
+    , resources ()
     , compact_output( compact_output )
     {}
 
 
 void Terminal_State_Viewer::render_state(const Application_State& state, Callback handler)
 {
-    resources = Resource_Loader(state);
+    {
+        Tracer::Span span(tracer.get(), "Resource_Loader::load", "resources");
+        resources.load(state);
+    }
 
     event_callback = handler;
 
-    return this->update();
+    return render();
 }
 
 void Terminal_State_Viewer::update()
 {
-    resources.update();
+    {
+        Tracer::Span span(tracer.get(), "Resource_Loader::update", "resources");
+        resources.update();
+    }
+    return render();
+}
+
+void Terminal_State_Viewer::render()
+{
     try
     {
-        render_view(resources.table.at("state_name"));
+        const std::string& view_name = resources.table.at("state_name");
+
+        Tracer::Span span(tracer.get(), (tracer) ? "render " + view_name : "", "view");
+        render_view(view_name);
     }
     catch(const std::out_of_range&)
     {
@@ -61,62 +76,51 @@ void Terminal_State_Viewer::update()
 
 void Terminal_State_Viewer::render_view(const std::string& view_name)
 {
-    std::string view = view_location + view_name + file_extension;
-    std::ifstream file(view);
-
-    if(file.is_open())
+    const std::string* view = load_view(view_name);
+    if(!view)
     {
-        char symbol;
-        while (file.get(symbol).good())
-        {
-            // Display characters until 'start command' character is reached
-            if (symbol == '<') 
-            { 
-                if (file.peek() == '@' && file.get(symbol).good())
-                {
-                    out_stream << read_resource(read_command(file));
-                }
-                else
-                {
-                    execute_command(read_command(file)); 
-                }
-            }
-            else               
-            { 
-                out_stream << symbol; 
-            }
-        }
+        out_stream << "Error: Unable to open view: " << view_location + view_name + file_extension << std::endl;
+        return;
     }
-    else
+
+    // Commands are spans of the view between '<' and '>', '<@' spans name a resource
+    for(size_t pos = 0; pos < view->size(); )
     {
-        out_stream << "Error: Unable to open view: " << view << std::endl;
+        size_t open = view->find('<', pos);
+        out_stream.write(view->data() + pos, std::min(open, view->size()) - pos);
+        if(open == std::string::npos) { break; }
+
+        bool   resource = open + 1 < view->size() && (*view)[open + 1] == '@';
+        size_t begin    = open + ((resource) ? 2 : 1);
+        size_t close    = std::min(view->find('>', begin), view->size());
+
+        std::string command = view->substr(begin, close - begin);
+        if(resource) { out_stream << read_resource(command); }
+        else         { execute_command(command); }
+
+        pos = close + 1;
     }
-    return file.close();
 }
 
-std::string Terminal_State_Viewer::read_command(std::ifstream& file)
+const std::string* Terminal_State_Viewer::load_view(const std::string& view_name)
 {
-    char symbol;
-    std::stringstream command;
+    auto cached = views.find(view_name);
+    if(cached != views.end()) { return &cached->second; }
 
-    // Consume symbols until end command character is reached
-    while(file.get(symbol).good() && symbol != '>')
-    {
-        command << symbol;
-    }
-    return command.str();
+    std::ifstream file(view_location + view_name + file_extension);
+    if(!file.is_open()) { return nullptr; }
+
+    std::stringstream view;
+    view << file.rdbuf();
+
+    return &views.emplace(view_name, view.str()).first->second;
 }
 
 std::string Terminal_State_Viewer::read_resource(const std::string& resource_name)
 {
-    try
-    {
-        return resources.table.at(resource_name);
-    }
-    catch(const std::out_of_range&)
-    {
-        return "Unknown Resource: " + resource_name;
-    }
+    auto resource = resources.table.find(resource_name);
+
+    return (resource == resources.table.end()) ? "Unknown Resource: " + resource_name : resource->second;
 }
 
 void Terminal_State_Viewer::execute_command(const std::string& command)
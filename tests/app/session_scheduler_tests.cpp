@@ -0,0 +1,159 @@
+/*
+
+File: session_scheduler_tests.cpp
+
+Brief: Unit tests for running sessions on fibers
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include <catch.hpp>
+#include <ChocAn/core/chocan.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/app/state_controller.hpp>
+#include <ChocAn/app/null_state_viewer.hpp>
+#include <ChocAn/app/session_scheduler.hpp>
+#include <ChocAn/app/session_input_controller.hpp>
+
+TEST_CASE("Scheduling sessions on fibers", "[session_scheduler]")
+{
+    SECTION("Yielding sessions on one thread take turns")
+    {
+        Session_Scheduler scheduler(1);
+        std::vector<int>  order;
+
+        // Spawned from a session, so none of them starts before all three are queued
+        scheduler.spawn([&]()
+        {
+            for(int session = 0; session < 3; ++session)
+            {
+                scheduler.spawn([&order, session]()
+                {
+                    for(int step = 0; step < 2; ++step)
+                    {
+                        order.push_back(session);
+                        Session_Scheduler::yield();
+                    }
+                } );
+            }
+        } );
+        scheduler.wait();
+
+        REQUIRE(order == std::vector<int>{ 0, 1, 2, 0, 1, 2 });
+        REQUIRE(scheduler.sessions() == 0);
+    }
+    SECTION("An exception thrown by a session is rethrown by wait")
+    {
+        Session_Scheduler scheduler(2);
+
+        scheduler.spawn([]() { throw std::runtime_error("session failed"); });
+        scheduler.spawn([]() { });
+
+        REQUIRE_THROWS_AS(scheduler.wait(), std::runtime_error);
+        REQUIRE_NOTHROW(scheduler.wait());
+    }
+    SECTION("Parking is only possible within a session")
+    {
+        REQUIRE(Session_Scheduler::current() == nullptr);
+        REQUIRE_THROWS_AS(Session_Scheduler::park(), std::logic_error);
+        REQUIRE_NOTHROW(Session_Scheduler::yield());
+    }
+    SECTION("Sessions parked when the scheduler is destroyed are unwound")
+    {
+        struct Unwind_Flag
+        {
+            std::atomic<bool>& flag;
+            std::thread::id&   thread;
+            ~Unwind_Flag() { thread = std::this_thread::get_id(); flag = true; }
+        };
+
+        std::atomic<bool> entered  { false };
+        std::atomic<bool> unwound  { false };
+        std::atomic<bool> returned { false };
+        std::thread::id   started_on, unwound_on;
+        {
+            Session_Scheduler scheduler(1);
+
+            scheduler.spawn([&]()
+            {
+                Unwind_Flag guard { unwound, unwound_on };
+                started_on = std::this_thread::get_id();
+                entered = true;
+                Session_Scheduler::park();
+                returned = true;
+            } );
+            while(!entered) { std::this_thread::yield(); }
+
+            REQUIRE(scheduler.sessions() == 1);
+        }
+        REQUIRE(unwound);
+        REQUIRE_FALSE(returned);
+        REQUIRE(unwound_on == started_on);
+        REQUIRE(unwound_on != std::this_thread::get_id());
+    }
+}
+
+TEST_CASE("Multiplexing State_Controller sessions waiting on input", "[session_scheduler], [state_controller]")
+{
+    const size_t sessions = 200;
+
+    Session_Scheduler scheduler(2);
+
+    std::vector<std::shared_ptr<Session_Input_Controller>> inputs;
+    std::atomic<size_t> exited { 0 };
+
+    for(size_t session = 0; session < sessions; ++session)
+    {
+        inputs.push_back(std::make_shared<Session_Input_Controller>());
+
+        scheduler.spawn([&exited, input = inputs.back()]()
+        {
+            State_Controller controller( std::make_shared<ChocAn>(std::make_shared<Mock_DB>())
+                                       , std::make_shared<Null_State_Viewer>()
+                                       , input );
+
+            while(!controller.end_state()) { controller.interact(); }
+
+            ++exited;
+        } );
+    }
+
+    // Sessions park on each read, so two threads carry all of them between lines
+    for(auto& input : inputs) { input->feed("1234"); }
+
+    REQUIRE(exited == 0);
+
+    for(auto& input : inputs) { input->feed("exit"); }
+
+    scheduler.wait();
+
+    REQUIRE(exited == sessions);
+}
+
+TEST_CASE("Reading fed input off the scheduler", "[session_input_controller]")
+{
+    Session_Input_Controller input;
+
+    std::thread feeder([&input]()
+    {
+        input.feed("1234");
+        input.close();
+    } );
+
+    REQUIRE(input.read_input() == "1234");
+    REQUIRE(input.read_input() == "exit");
+
+    feeder.join();
+}
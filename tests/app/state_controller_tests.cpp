@@ -22,6 +22,10 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <ChocAn/data/mock_db.hpp>
 #include <ChocAn/app/state_viewer.hpp>
 #include <ChocAn/app/state_controller.hpp>
+#include <ChocAn/app/null_state_viewer.hpp>
+#include <ChocAn/app/transition_metrics.hpp>
+#include <ChocAn/app/replay_input_controller.hpp>
+#include <ChocAn/app/scripted_input_controller.hpp>
 #include <ChocAn/view/terminal_input_controller.hpp>
 #include <ChocAn/view/terminal_state_viewer.hpp>
 
@@ -289,6 +293,15 @@ TEST_CASE("Add_Transaction State Behavior", "[add_transaction], [state_controlle
 
         REQUIRE(std::holds_alternative<Confirm_Transaction>(controller.current_state()));
     }
+    SECTION("Add transaction transitions to Confirm Transaction from a one line claim")
+    {
+        mocks.in_stream << "1234\n6789|10-13-2019|123456|comments\n";
+
+        controller.interact();
+        controller.interact();
+
+        REQUIRE(std::holds_alternative<Confirm_Transaction>(controller.current_state()));
+    }
     SECTION("Add transaction transitions back to provider menu on input 'cancel'")
     {
         // This input sequence will change if we make changes to the transaction builder
@@ -452,6 +465,15 @@ TEST_CASE("Find Account State behavior", "[find_account], [state_controller]")
 
         REQUIRE(std::holds_alternative<Find_Account>(controller.interact().current_state()));
     }
+    SECTION("Find Account lists the member accounts matching a name or address search")
+    {
+        mocks.in_stream << "portland\n";
+
+        Application_State state = controller.interact().current_state();
+
+        REQUIRE(std::holds_alternative<Find_Account>(state));
+        REQUIRE(std::get<Find_Account>(state).matches.size() == 2);
+    }
 }
 
 TEST_CASE("Generate Report state behavior", "[generate_report], [state_controller]")
@@ -483,6 +505,133 @@ TEST_CASE("Generate Report state behavior", "[generate_report], [state_controlle
     }
 }
 
+TEST_CASE("Viewing a generated report", "[view_report], [state_controller]")
+{
+    mock_dependencies mocks;
+
+    State_Controller controller( mocks.chocan
+                               , mocks.state_viewer
+                               , mocks.input_controller
+                               , Manager_Menu() );
+
+    mocks.chocan->login_manager.login(5678);
+
+    mocks.in_stream << "4\nall\n\n";
+
+    controller.interact(); // Transition to Generate Report with the manager menu on the runtime stack
+    controller.interact(); // Date range is filled
+    controller.interact(); // Summary report is generated
+
+    SECTION("The report is held through a shared handle, then the previous menu is restored")
+    {
+        const View_Report& view = std::get<View_Report>(controller.current_state());
+
+        REQUIRE(view.report);
+        REQUIRE(std::holds_alternative<Summary_Report>(*view.report));
+        REQUIRE(std::holds_alternative<Manager_Menu>(controller.interact().current_state()));
+    }
+}
+
+TEST_CASE("Paging through a report", "[view_report], [state_controller]")
+{
+    mock_dependencies mocks;
+
+    // 45 transactions fill three pages
+    Data_Gateway::Transactions transactions;
+    Data_Gateway::Transactions filed = mocks.db->get_transactions(DateTime(0), DateTime::get_current_datetime());
+    while(transactions.size() < 45) { transactions.push_back(filed[transactions.size() % filed.size()]); }
+
+    Account member = mocks.db->get_account(6789).value();
+
+    State_Controller controller( mocks.chocan
+                               , mocks.state_viewer
+                               , mocks.input_controller
+                               , View_Report { std::make_shared<const ChocAn_Report>(Member_Report(member, transactions)) } );
+
+    auto page = [&]() { return std::get<View_Report>(controller.current_state()).page; };
+    auto status = [&]() { return std::get<View_Report>(controller.current_state()).status; };
+
+    SECTION("'next' and 'prev' move between pages within the report")
+    {
+        REQUIRE(std::get<View_Report>(controller.current_state()).page_count() == 3);
+
+        mocks.in_stream << "prev\nnext\nnext\nnext\nprev\n";
+
+        controller.interact();
+        REQUIRE(page() == 0);
+        REQUIRE_FALSE(status().empty());
+
+        controller.interact();
+        controller.interact();
+        REQUIRE(page() == 2);
+        REQUIRE(status().empty());
+
+        controller.interact();
+        REQUIRE(page() == 2);
+        REQUIRE_FALSE(status().empty());
+
+        controller.interact();
+        REQUIRE(page() == 1);
+    }
+    SECTION("'page N' jumps to a page, out of range pages are rejected")
+    {
+        mocks.in_stream << "page 3\npage 9\npage two\npage 2abc\n";
+
+        controller.interact();
+        REQUIRE(page() == 2);
+
+        controller.interact();
+        REQUIRE(page() == 2);
+        REQUIRE(status() == "Page must be between 1-3");
+
+        controller.interact();
+        REQUIRE(status() == "Page must be between 1-3");
+
+        controller.interact();
+        REQUIRE(page() == 2);
+        REQUIRE(status() == "Page must be between 1-3");
+    }
+    SECTION("Any other input leaves the report")
+    {
+        mocks.in_stream << "\n";
+
+        REQUIRE_FALSE(std::holds_alternative<View_Report>(controller.interact().current_state()));
+    }
+    SECTION("Paging commands leave a report that fits on one page")
+    {
+        State_Controller single_page( mocks.chocan
+                                    , mocks.state_viewer
+                                    , mocks.input_controller
+                                    , View_Report { std::make_shared<const ChocAn_Report>(Member_Report(member, filed)) } );
+
+        mocks.in_stream << "next\n";
+
+        REQUIRE_FALSE(std::holds_alternative<View_Report>(single_page.interact().current_state()));
+    }
+}
+
+TEST_CASE("Returning from a nested state restores the previous state", "[runtime], [state_controller]")
+{
+    mock_dependencies mocks;
+
+    State_Controller controller( mocks.chocan
+                               , mocks.state_viewer
+                               , mocks.input_controller
+                               , Add_Transaction{&mocks.chocan->transaction_builder.reset()} );
+
+    // Each request for help pushes the transaction state and views the directory
+    for(size_t i = 0; i < State_Controller::max_history + 4; ++i)
+    {
+        mocks.in_stream << "help\n\n";
+
+        controller.interact();
+        REQUIRE(std::holds_alternative<View_Service_Directory>(controller.current_state()));
+
+        controller.interact();
+        REQUIRE(std::holds_alternative<Add_Transaction>(controller.current_state()));
+    }
+}
+
 TEST_CASE("Delete account state behavior", "[delete_account], [state_controller]")
 {
     mock_dependencies mocks;
@@ -511,4 +660,126 @@ TEST_CASE("Delete account state behavior", "[delete_account], [state_controller]
 
         REQUIRE(mocks.db->get_account(1234));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("State controller tracing", "[tracing], [state_controller]")
+{
+    mock_dependencies mocks;
+
+    auto tracer = std::make_shared<Tracer>();
+
+    State_Controller controller( mocks.chocan
+                               , mocks.state_viewer
+                               , mocks.input_controller
+                               , Login());
+    controller.enable_tracing(tracer);
+
+    SECTION("Each interaction records a span named after the state with its input nested inside")
+    {
+        mocks.in_stream << "garbage\n";
+
+        controller.interact();
+
+        auto events = tracer->events();
+
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].name == "read_input");
+        REQUIRE(events[0].category == "input");
+        REQUIRE(events[1].name == "Login");
+        REQUIRE(events[1].category == "state");
+    }
+}
+
+TEST_CASE("Recording and replaying a session", "[replay], [state_controller]")
+{
+    mock_dependencies mocks;
+    std::stringstream session;
+
+    State_Controller recorded( mocks.chocan
+                             , mocks.state_viewer
+                             , mocks.input_controller
+                             , Login());
+    recorded.enable_recording(session);
+
+    mocks.in_stream << "garbage\n" << "1234\n" << "0\n";
+    recorded.interact().interact().interact();
+
+    SECTION("Each line of input is recorded with the state that read it")
+    {
+        std::string offset, state, input;
+
+        std::getline(session, offset, '\t');
+        std::getline(session, state, '\t');
+        std::getline(session, input);
+
+        REQUIRE(state == "Login");
+        REQUIRE(input == "garbage");
+    }
+    SECTION("Replaying the session without rendering reaches the same states")
+    {
+        auto replay = std::make_shared<Replay_Input_Controller>(session);
+
+        State_Controller replayed( std::make_unique<ChocAn>(std::make_unique<Mock_DB>())
+                                 , std::make_shared<Null_State_Viewer>()
+                                 , replay
+                                 , Login());
+        Transition_Metrics transitions;
+
+        while(!replayed.end_state())
+        {
+            std::string from = State_Controller::state_name(replayed.current_state());
+            replayed.interact();
+            transitions.record(from, State_Controller::state_name(replayed.current_state()), Transition_Metrics::Duration(1));
+        }
+
+        REQUIRE(replay->lines() == 3);
+        REQUIRE(replay->last_recorded_state() == "Provider_Menu");
+        REQUIRE(transitions.transitions().count({ "Login", "Provider_Menu" }));
+        REQUIRE(transitions.from("Login").count() == 3);
+        REQUIRE(transitions.from("Provider_Menu").count() == 1);
+    }
+}
+
+TEST_CASE("Driving a session from scripts", "[load], [state_controller]")
+{
+    mock_dependencies mocks;
+
+    std::vector<Scripted_Input_Controller::Script> scripts { { "1234" }, { "4", "6789", "" } };
+    auto input = std::make_shared<Scripted_Input_Controller>([&]()
+    {
+        if(scripts.empty()) { return Scripted_Input_Controller::Script(); }
+
+        auto script = scripts.front();
+        scripts.erase(scripts.begin());
+        return script;
+    } );
+
+    State_Controller controller( mocks.chocan
+                               , std::make_shared<Null_State_Viewer>()
+                               , input
+                               , Login());
+    Transition_Metrics session;
+
+    while(!controller.end_state())
+    {
+        std::string from = State_Controller::state_name(controller.current_state());
+        controller.interact();
+        session.record(from, State_Controller::state_name(controller.current_state()), Transition_Metrics::Duration(2));
+    }
+
+    SECTION("Every script runs and the session exits once they are used up")
+    {
+        REQUIRE(scripts.empty());
+        REQUIRE(session.transitions().count({ "Find_Account", "View_Account" }));
+        REQUIRE(session.transitions().count({ "Provider_Menu", "Exit" }));
+    }
+    SECTION("Sessions merge into one set of metrics")
+    {
+        Transition_Metrics total;
+        total.merge(session);
+        total.merge(session);
+
+        REQUIRE(total.count() == 2 * session.count());
+        REQUIRE(total.from("Login").max() == Transition_Metrics::Duration(2));
+    }
+}
@@ -105,8 +105,8 @@ TEST_CASE("Constructing Summary Reports", "[summary_report], [constructors]")
     Account provider2 = mock_db.get_provider_account(1111).value();
 
     // Mock DB holds transaction data for the Provider with ID 1234
-    Provider_Activity activity { { provider1, mock_db.get_transactions(start, current,provider1) }
-                               , { provider2, mock_db.get_transactions(start, current,provider2) } };
+    Provider_Activity activity { Provider_Report(provider1, mock_db.get_transactions(start, current,provider1))
+                               , Provider_Report(provider2, mock_db.get_transactions(start, current,provider2)) };
     
     SECTION("Summary Reports are constructed with a list of Provider Reports")
     {
@@ -118,6 +118,31 @@ TEST_CASE("Constructing Summary Reports", "[summary_report], [constructors]")
     }
 }
 
+TEST_CASE("Summarizing provider activity", "[provider_summary], [constructors]")
+{
+    Mock_DB mock_db;
+
+    Account provider = mock_db.get_provider_account(1234).value();
+    Account member   = mock_db.get_member_account(6789).value();
+
+    Provider_Report report (provider, mock_db.get_transactions(DateTime(0), DateTime::get_current_datetime(), provider));
+
+    SECTION("A summary of a provider report keeps its totals")
+    {
+        Provider_Summary summary(report);
+
+        REQUIRE(summary.services_rendered() == report.services_rendered());
+        REQUIRE(summary.total_fee().value == report.total_fee().value);
+    }
+    SECTION("Provider summaries cannot be constructed with a non-provider account or unrelated claims")
+    {
+        Provider_Summary::Claims claims = Provider_Summary(report).claims();
+
+        REQUIRE_THROWS_AS(Provider_Summary(member, { }), std::logic_error);
+        REQUIRE_THROWS_AS(Provider_Summary(mock_db.get_provider_account(1111).value(), claims), std::logic_error);
+    }
+}
+
 TEST_CASE("Calculating total cost and total number of services rendered")
 {
     using Provider_Activity = Summary_Report::Provider_Activity;
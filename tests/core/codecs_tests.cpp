@@ -0,0 +1,104 @@
+/*
+
+File: codecs_tests.cpp
+
+Brief: Unit tests for the account type, status, and state code codecs
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/core/utils/codecs.hpp>
+#include <ChocAn/core/entities/account.hpp>
+
+TEST_CASE("Encoding and decoding account types and statuses", "[codecs]")
+{
+    using Codecs::Account_Kind;
+
+    SECTION("Account kinds round trip through their names")
+    {
+        for(Account_Kind kind : { Account_Kind::Manager, Account_Kind::Member, Account_Kind::Provider })
+        {
+            REQUIRE(Codecs::decode_account_kind(Codecs::encode(kind)) == kind);
+        }
+    }
+    SECTION("Unknown or differently cased names do not decode")
+    {
+        REQUIRE_FALSE(Codecs::decode_account_kind("member"));
+        REQUIRE_FALSE(Codecs::decode_account_kind("Members"));
+        REQUIRE_FALSE(Codecs::decode_account_kind(""));
+        REQUIRE_FALSE(Codecs::decode_account_status("Expired"));
+    }
+    SECTION("Statuses round trip through their names")
+    {
+        REQUIRE(Codecs::decode_account_status("Valid") == Account_Status::Valid);
+        REQUIRE(Codecs::decode_account_status(Codecs::encode(Account_Status::Suspended)) == Account_Status::Suspended);
+    }
+}
+
+TEST_CASE("Validating US state codes", "[codecs]")
+{
+    SECTION("All 50 states are accepted")
+    {
+        unsigned states = 0;
+        for(char first = 'A'; first <= 'Z'; ++first)
+        {
+            for(char second = 'A'; second <= 'Z'; ++second)
+            {
+                states += Codecs::is_us_state(std::string { first, second });
+            }
+        }
+        REQUIRE(states == 50);
+    }
+    SECTION("Codes that are not two upper case letters are rejected")
+    {
+        REQUIRE_FALSE(Codecs::is_us_state("or"));
+        REQUIRE_FALSE(Codecs::is_us_state("ORE"));
+        REQUIRE_FALSE(Codecs::is_us_state("O"));
+        REQUIRE_FALSE(Codecs::is_us_state("1A"));
+    }
+}
+
+TEST_CASE("Hydrating accounts with the codecs", "[codecs], [account]")
+{
+    Mock_DB mock_db;
+
+    Account::Data_Table data
+    {
+        { "f_name", "Jane" }, { "l_name", "Doe" }, { "street", "1234 Lame St." }, { "city", "Portland" },
+        { "state", "OR" }, { "zip", "97236" }, { "chocan_id", "321321321" }, { "type", "Member" }, { "status", "Suspended" }
+    };
+
+    SECTION("Member status is decoded from the table")
+    {
+        Account account(data, mock_db.get_db_key());
+
+        REQUIRE(std::get<Member>(account.type()).status() == Account_Status::Suspended);
+        REQUIRE(account.serialize() == data);
+    }
+    SECTION("Unknown account types are rejected")
+    {
+        data["type"] = "Admin";
+
+        REQUIRE_THROWS(Account(data, mock_db.get_db_key()));
+    }
+    SECTION("Malformed rows decode to an error instead of throwing")
+    {
+        REQUIRE(Account::decode(data, mock_db.get_db_key())->id() == 321321321);
+
+        data["chocan_id"] = "32132132x";
+        REQUIRE(Account::decode(data, mock_db.get_db_key()).error() == Error_Code::Malformed_Row);
+
+        data.erase("zip");
+        REQUIRE(Account::decode(data, mock_db.get_db_key()).error() == Error_Code::Malformed_Row);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+
+File: cursor_tests.cpp
+
+Brief: Unit tests for batched cursors
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <vector>
+#include <catch.hpp>
+#include <ChocAn/core/utils/cursor.hpp>
+
+TEST_CASE("Reading rows through a cursor", "[cursor]")
+{
+    // Counts up to 10, resuming after the last value returned
+    std::vector<size_t> limits;
+    auto fetch = [&, last = 0](size_t limit) mutable
+    {
+        limits.push_back(limit);
+
+        std::vector<int> batch;
+        while(last < 10 && batch.size() < limit) { batch.push_back(++last); }
+        return batch;
+    };
+
+    SECTION("Rows are fetched a batch at a time")
+    {
+        Cursor<int> cursor(fetch, 4);
+
+        REQUIRE(cursor.next() == 1);
+        REQUIRE(limits.size() == 1);
+
+        std::vector<int> rest = cursor.drain();
+
+        REQUIRE(rest.size() == 9);
+        REQUIRE(rest.back() == 10);
+        REQUIRE(limits.size() == 4); // 4 + 4 + 2, then an empty batch ends the query
+        REQUIRE_FALSE(cursor.next());
+    }
+    SECTION("Cursors can be consumed with range-for")
+    {
+        int sum = 0;
+        for(int value : Cursor<int>(fetch, 3)) { sum += value; }
+
+        REQUIRE(sum == 55);
+    }
+    SECTION("The batch size can be changed between fetches")
+    {
+        Cursor<int> cursor(fetch, 2);
+        cursor.next();
+        cursor.next();
+        cursor.set_batch_size(8);
+        cursor.next();
+
+        REQUIRE(limits == std::vector<size_t> { 2, 8 });
+    }
+    SECTION("An empty cursor returns nothing")
+    {
+        REQUIRE_FALSE(Cursor<int>::empty().next());
+    }
+}
@@ -0,0 +1,94 @@
+/*
+
+File: id_bitmap_tests.cpp
+
+Brief: Unit tests for the compressed ID bitmap
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/core/utils/id_bitmap.hpp>
+
+TEST_CASE("Inserting and erasing IDs", "[id_bitmap]")
+{
+    ID_Bitmap bitmap;
+
+    SECTION("An ID is present once inserted and absent once erased")
+    {
+        REQUIRE(bitmap.insert(123456789));
+        REQUIRE_FALSE(bitmap.insert(123456789));
+        REQUIRE(bitmap.contains(123456789));
+        REQUIRE_FALSE(bitmap.contains(123456788));
+        REQUIRE(bitmap.size() == 1);
+
+        REQUIRE(bitmap.erase(123456789));
+        REQUIRE_FALSE(bitmap.erase(123456789));
+        REQUIRE_FALSE(bitmap.contains(123456789));
+        REQUIRE(bitmap.empty());
+        REQUIRE(bitmap.bytes() == 0);
+    }
+    SECTION("A sparse set holds two bytes per ID")
+    {
+        for(uint32_t id = 100000000; id < 100000000 + 100 * 1000; id += 1000) { bitmap.insert(id); }
+
+        REQUIRE(bitmap.size() == 100);
+        REQUIRE(bitmap.bytes() < 100 * 2 + 4 * 128);
+    }
+    SECTION("IDs sharing their low bits are kept apart")
+    {
+        bitmap.insert(0x00010005);
+        bitmap.insert(0x00020005);
+
+        REQUIRE(bitmap.contains(0x00010005));
+        REQUIRE_FALSE(bitmap.contains(0x00030005));
+        REQUIRE(bitmap.erase(0x00010005));
+        REQUIRE(bitmap.contains(0x00020005));
+    }
+}
+
+TEST_CASE("Dense and sparse groups", "[id_bitmap]")
+{
+    ID_Bitmap bitmap;
+    const uint32_t base = 500000000 & ~0xFFFFu;
+
+    for(uint32_t id = base; id < base + 2 * ID_Bitmap::array_limit; id += 2) { bitmap.insert(id); }
+
+    SECTION("A group past the array limit switches to a bitmap and keeps its IDs")
+    {
+        bitmap.insert(base + 1);
+
+        REQUIRE(bitmap.size() == ID_Bitmap::array_limit + 1);
+        REQUIRE(bitmap.bytes() < 65536 / 8 + 128);
+        REQUIRE(bitmap.contains(base + 1));
+        REQUIRE(bitmap.contains(base + 2 * ID_Bitmap::array_limit - 2));
+        REQUIRE_FALSE(bitmap.contains(base + 3));
+    }
+    SECTION("Erasing back under the limit keeps the remaining IDs")
+    {
+        bitmap.insert(base + 1);
+        bitmap.erase(base + 1);
+        bitmap.erase(base + 2);
+
+        REQUIRE(bitmap.size() == ID_Bitmap::array_limit - 1);
+        REQUIRE(bitmap.contains(base));
+        REQUIRE_FALSE(bitmap.contains(base + 2));
+        REQUIRE_FALSE(bitmap.contains(base + 1));
+    }
+    SECTION("IDs inserted out of order are found")
+    {
+        for(uint32_t id = 999999999; id > 999999999 - 1000; id -= 7) { bitmap.insert(id); }
+
+        REQUIRE(bitmap.contains(999999999 - 7 * 100));
+        REQUIRE_FALSE(bitmap.contains(999999999 - 7 * 100 - 1));
+        REQUIRE(bitmap.contains(base + 4));
+    }
+}
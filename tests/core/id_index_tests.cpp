@@ -0,0 +1,62 @@
+/*
+
+File: id_index_tests.cpp
+
+Brief: Unit tests for the ID index of account IDs and member status
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/core/id_index.hpp>
+#include <ChocAn/data/mock_db.hpp>
+
+TEST_CASE("Answering ID lookups from the index", "[id_index]")
+{
+    Mock_DB db;
+
+    SECTION("Every account is indexed with its member status")
+    {
+        REQUIRE(db.id_index().size() == 5);
+        REQUIRE(db.id_index().exists(5678));
+        REQUIRE_FALSE(db.id_index().exists(4242));
+
+        REQUIRE(db.member_status(6789).value() == Account_Status::Valid);
+        REQUIRE(db.member_status(9876).value() == Account_Status::Suspended);
+        REQUIRE(db.member_status(1234).error() == Error_Code::Wrong_Type);
+        REQUIRE(db.member_status(4242).error() == Error_Code::Not_Found);
+    }
+    SECTION("Account writes through the gateway update the index")
+    {
+        db.id_index();
+
+        Account member = db.get_account(9876).value();
+        db.update_account(Account(member.name(), member.address(), Member(), 9876, db.get_db_key()));
+        db.update_account(Account(member.name(), member.address(), Provider(), 6789, db.get_db_key()));
+        db.create_account(Account(member.name(), member.address(), Member(Account_Status::Suspended), 4242, db.get_db_key()));
+        db.delete_account(1234);
+
+        REQUIRE(db.member_status(9876).value() == Account_Status::Valid);
+        REQUIRE(db.member_status(6789).error() == Error_Code::Wrong_Type);
+        REQUIRE(db.member_status(4242).value() == Account_Status::Suspended);
+        REQUIRE_FALSE(db.id_index().exists(1234));
+    }
+    SECTION("A copied gateway indexes its own accounts")
+    {
+        db.id_index();
+
+        Mock_DB copy = db;
+        copy.delete_account(6789);
+
+        REQUIRE(copy.member_status(6789).error() == Error_Code::Not_Found);
+        REQUIRE(db.member_status(6789).value() == Account_Status::Valid);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+
+File: report_cache_tests.cpp
+
+Brief: Unit tests for the report cache and its invalidation rules
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/core/reporter.hpp>
+#include <ChocAn/core/report_cache.hpp>
+
+TEST_CASE("Reporter shares cached reports", "[reporter], [report_cache]")
+{
+    auto db = std::make_shared<Mock_DB>();
+    Reporter reporter(db);
+
+    DateTime start(1574300000);
+    DateTime end(1574500000);
+
+    Account provider = db->get_provider_account(1234).value();
+    Account member   = db->get_member_account(6789).value();
+
+    Reporter::Report_Ptr summary = reporter.summary_report(start, end);
+
+    SECTION("Repeat requests for a range return the same report")
+    {
+        REQUIRE(reporter.summary_report(start, end) == summary);
+        REQUIRE(reporter.provider_report(start, end, provider) == reporter.provider_report(start, end, provider));
+        REQUIRE(reporter.cache().size() == 2);
+    }
+    SECTION("Reports of different ranges or types are cached separately")
+    {
+        REQUIRE(reporter.summary_report(start, DateTime(1574600000)) != summary);
+        REQUIRE(reporter.member_report(start, end, member) != reporter.provider_report(start, end, provider));
+        REQUIRE(reporter.cache().size() == 4);
+    }
+    SECTION("A transaction inside the range regenerates the report")
+    {
+        db->add_transaction(Transaction(provider, member, DateTime(1574400000), db->lookup_service(123456).value(), ""));
+
+        Reporter::Report_Ptr regenerated = reporter.summary_report(start, end);
+        REQUIRE(regenerated != summary);
+        REQUIRE(std::get<Summary_Report>(*regenerated).num_services() == std::get<Summary_Report>(*summary).num_services() + 1);
+    }
+    SECTION("A transaction outside the range keeps the report")
+    {
+        db->add_transaction(Transaction(provider, member, DateTime(1574900000), db->lookup_service(123456).value(), ""));
+
+        REQUIRE(reporter.summary_report(start, end) == summary);
+    }
+}
+
+TEST_CASE("Report cache invalidation", "[report_cache]")
+{
+    using Key = Report_Cache::Key;
+    using Report_Type = Report_Cache::Report_Type;
+
+    auto db    = std::make_shared<Mock_DB>();
+    auto cache = std::make_shared<Report_Cache>();
+    db->subscribe(cache);
+
+    Reporter reporter(db);
+
+    Account arman  = db->get_provider_account(1234).value();
+    Account other  = db->get_provider_account(1111).value();
+    Account member = db->get_member_account(6789).value();
+
+    // Arman's claims fall in the first range, the other provider's in the second
+    DateTime start(1574300000), middle(1574500000), end(1574700000);
+
+    Key arman_key   { Report_Type::Provider, 1234, start.unix_timestamp(), middle.unix_timestamp() };
+    Key other_key   { Report_Type::Provider, 1111, middle.unix_timestamp(), end.unix_timestamp() };
+    Key summary_key { Report_Type::Summary, 0, start.unix_timestamp(), middle.unix_timestamp() };
+
+    cache->insert(arman_key, std::make_shared<const ChocAn_Report>(reporter.gen_provider_report(start, middle, arman)));
+    cache->insert(other_key, std::make_shared<const ChocAn_Report>(reporter.gen_provider_report(middle, end, other)));
+    cache->insert(summary_key, std::make_shared<const ChocAn_Report>(reporter.gen_summary_report(start, middle)));
+
+    SECTION("Transactions only drop reports of their providers and members whose range holds them")
+    {
+        db->add_transaction(Transaction(other, member, DateTime(1574400000), db->lookup_service(123456).value(), ""));
+
+        REQUIRE(cache->find(arman_key));
+        REQUIRE(cache->find(other_key));
+        REQUIRE_FALSE(cache->find(summary_key));
+    }
+    SECTION("Updating an account drops the reports it appears in")
+    {
+        db->update_account(member);
+
+        REQUIRE_FALSE(cache->find(arman_key));
+        REQUIRE_FALSE(cache->find(other_key));
+        REQUIRE_FALSE(cache->find(summary_key));
+    }
+    SECTION("Updating an account outside every report keeps them")
+    {
+        db->update_account(db->get_manager_account(5678).value());
+
+        REQUIRE(cache->size() == 3);
+    }
+    SECTION("A provider joining or leaving drops summaries")
+    {
+        db->delete_account(1111);
+
+        REQUIRE(cache->find(arman_key));
+        REQUIRE_FALSE(cache->find(other_key));
+        REQUIRE_FALSE(cache->find(summary_key));
+    }
+    SECTION("Changing a service drops the reports that billed it")
+    {
+        db->add_service(db->lookup_service(111111).value());
+
+        REQUIRE(cache->find(arman_key));
+        REQUIRE_FALSE(cache->find(other_key));
+        REQUIRE(cache->find(summary_key));
+    }
+    SECTION("Expired caches are dropped by the gateway")
+    {
+        cache.reset();
+        REQUIRE(db->add_transaction(Transaction(arman, member, DateTime(1574400000), db->lookup_service(123456).value(), "")));
+    }
+}
+
+TEST_CASE("Report cache evicts the least recently used report", "[report_cache]")
+{
+    using Key = Report_Cache::Key;
+
+    Report_Cache cache(2);
+    auto report = std::make_shared<const ChocAn_Report>(Summary_Report(DateTime(0), DateTime(1), { }));
+
+    Key first  { Report_Cache::Report_Type::Summary, 0, 0, 1 };
+    Key second { Report_Cache::Report_Type::Summary, 0, 0, 2 };
+    Key third  { Report_Cache::Report_Type::Summary, 0, 0, 3 };
+
+    cache.insert(first, report);
+    cache.insert(second, report);
+    cache.find(first);
+    cache.insert(third, report);
+
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.find(first));
+    REQUIRE_FALSE(cache.find(second));
+    REQUIRE(cache.find(third));
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
@@ -0,0 +1,82 @@
+/*
+
+File: result_tests.cpp
+
+Brief: Unit tests for the Result type and the non-throwing gateway lookups
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <string>
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/core/utils/result.hpp>
+#include <ChocAn/core/utils/codecs.hpp>
+
+TEST_CASE("Holding a value or an error", "[result]")
+{
+    SECTION("A result built from a value holds that value")
+    {
+        Result<std::string> result = std::string("1234");
+
+        REQUIRE(result);
+        REQUIRE(*result == "1234");
+        REQUIRE(result->size() == 4);
+        REQUIRE(std::move(result).to_optional() == "1234");
+    }
+    SECTION("A result built from an error holds only the error")
+    {
+        Result<std::string> result = Error_Code::Not_Found;
+
+        REQUIRE_FALSE(result);
+        REQUIRE(result.error() == Error_Code::Not_Found);
+        REQUIRE(result.value_or("none") == "none");
+        REQUIRE_FALSE(std::move(result).to_optional());
+    }
+}
+
+TEST_CASE("Decoding numbers without throwing", "[result], [codecs]")
+{
+    SECTION("Plain digits decode")
+    {
+        REQUIRE(Codecs::decode_id("123456789").value() == 123456789u);
+        REQUIRE(Codecs::decode_number<long>("1577836800").value() == 1577836800l);
+    }
+    SECTION("Anything but plain digits in range is malformed")
+    {
+        for(const char* input : { "", "abc", "12a", " 12", "-12", "+12", "99999999999" })
+        {
+            auto id = Codecs::decode_id(input);
+
+            REQUIRE_FALSE(id);
+            REQUIRE(id.error() == Error_Code::Malformed_Number);
+        }
+    }
+}
+
+TEST_CASE("Looking up accounts and services with results", "[result], [data_gateway]")
+{
+    Mock_DB db;
+
+    SECTION("Lookups report why they failed")
+    {
+        REQUIRE(db.find_account("1234", Codecs::Account_Kind::Provider)->id() == 1234);
+        REQUIRE(db.find_account("not an id").error() == Error_Code::Malformed_Number);
+        REQUIRE(db.find_account("4242").error() == Error_Code::Not_Found);
+        REQUIRE(db.find_account("1234", Codecs::Account_Kind::Member).error() == Error_Code::Wrong_Type);
+    }
+    SECTION("Services are looked up by code")
+    {
+        REQUIRE(db.find_service("123456")->code() == 123456u);
+        REQUIRE(db.find_service("0").error() == Error_Code::Not_Found);
+        REQUIRE(db.find_service("massage").error() == Error_Code::Malformed_Number);
+    }
+}
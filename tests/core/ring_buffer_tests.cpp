@@ -0,0 +1,59 @@
+/*
+
+File: ring_buffer_tests.cpp
+
+Brief: Unit tests for the fixed capacity ring buffer
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <memory>
+#include <string>
+#include <catch.hpp>
+#include <ChocAn/core/utils/ring_buffer.hpp>
+
+TEST_CASE("Pushing and popping a ring buffer", "[ring_buffer]")
+{
+    Ring_Buffer<std::string, 3> ring { "first" };
+
+    SECTION("The newest element is on top")
+    {
+        ring.push("second");
+
+        REQUIRE(ring.size() == 2);
+        REQUIRE(ring.top() == "second");
+        REQUIRE(ring.pop() == "second");
+        REQUIRE(ring.pop() == "first");
+        REQUIRE(ring.empty());
+    }
+    SECTION("Pushing onto a full buffer overwrites the oldest element")
+    {
+        ring.push("second");
+        ring.push("third");
+        ring.push("fourth");
+
+        REQUIRE(ring.size() == ring.capacity());
+        REQUIRE(ring.pop() == "fourth");
+        REQUIRE(ring.pop() == "third");
+        REQUIRE(ring.pop() == "second");
+        REQUIRE(ring.empty());
+    }
+    SECTION("Elements are moved in and out of the buffer")
+    {
+        Ring_Buffer<std::unique_ptr<int>, 2> handles;
+
+        handles.push(std::make_unique<int>(7));
+        std::unique_ptr<int> handle = handles.pop();
+
+        REQUIRE(*handle == 7);
+        REQUIRE(handles.empty());
+    }
+}
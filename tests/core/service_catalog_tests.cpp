@@ -0,0 +1,163 @@
+/*
+
+File: service_catalog_tests.cpp
+
+Brief: Unit tests for the service catalog and its version based refresh
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/core/service_catalog.hpp>
+
+TEST_CASE("Service catalog orderings", "[orderings], [service_catalog]")
+{
+    Mock_DB db;
+
+    Service_Catalog catalog(db.service_directory(), 1);
+
+    SECTION("Services are ordered by code")
+    {
+        REQUIRE(catalog.size() == 3);
+        REQUIRE(catalog.by_code()[0].code() == 111111);
+        REQUIRE(catalog.by_code()[1].code() == 123456);
+        REQUIRE(catalog.by_code()[2].code() == 222222);
+    }
+    SECTION("Services are ordered by name")
+    {
+        REQUIRE(catalog.by_name()[0].name() == "Addiction Consulting");
+        REQUIRE(catalog.by_name()[1].name() == "Addiction Treatment");
+        REQUIRE(catalog.by_name()[2].name() == "Back Rub");
+    }
+    SECTION("Services are looked up by code")
+    {
+        REQUIRE(catalog.lookup(123456).value().name() == "Back Rub");
+        REQUIRE_FALSE(catalog.lookup(0));
+        REQUIRE_FALSE(catalog.lookup(999999));
+    }
+}
+
+TEST_CASE("Sharing and refreshing the service catalog", "[service_catalog], [data_gateway]")
+{
+    SECTION("The same catalog is shared until the services change")
+    {
+        Mock_DB db;
+
+        auto catalog = db.service_catalog();
+
+        REQUIRE(db.service_catalog() == catalog);
+
+        db.add_service(Service(333333, USD { 10.00 }, "Chocolate Detox", db.get_db_key()));
+
+        auto refreshed = db.service_catalog();
+
+        REQUIRE(refreshed != catalog);
+        REQUIRE(refreshed->size() == 4);
+        REQUIRE(catalog->size() == 3);
+    }
+    SECTION("SQLite triggers advance the services version")
+    {
+        const char* sql_file = "chocan_catalog_test.sql";
+
+        SQLite_DB db(":memory:", "chocan_schema.sql");
+
+        auto catalog = db.service_catalog();
+
+        REQUIRE(catalog->size() == db.service_directory().size());
+        REQUIRE(db.service_catalog() == catalog);
+        {
+            std::ofstream sql(sql_file);
+            sql << "UPDATE services SET cost=1 WHERE code=123456;";
+        }
+        REQUIRE(db.load_schema(sql_file));
+        std::remove(sql_file);
+
+        REQUIRE(db.services_version() > catalog->version());
+        REQUIRE(db.service_catalog()->lookup(123456).value().cost().value == 1);
+    }
+    SECTION("Connections to the same database share one catalog")
+    {
+        const char* db_file = "chocan_catalog_test.db";
+        std::remove(db_file);
+
+        SQLite_DB(":memory:", "chocan_schema.sql").backup_to(db_file);
+        {
+            SQLite_DB first(db_file);
+            SQLite_DB second(db_file);
+
+            REQUIRE(first.store_id() == second.store_id());
+            REQUIRE(first.service_catalog() == second.service_catalog());
+
+            {
+                std::ofstream sql("chocan_catalog_test.sql");
+                sql << "UPDATE services SET cost=1 WHERE code=123456;";
+            }
+            REQUIRE(first.load_schema("chocan_catalog_test.sql"));
+            std::remove("chocan_catalog_test.sql");
+
+            REQUIRE(second.service_catalog()->lookup(123456).value().cost().value == 1);
+            REQUIRE(first.service_catalog() == second.service_catalog());
+        }
+        std::remove(db_file);
+    }
+    SECTION("Separate in memory stores do not share a catalog")
+    {
+        Mock_DB first;
+        Mock_DB second;
+
+        REQUIRE(first.store_id() != second.store_id());
+        REQUIRE(first.service_catalog() != second.service_catalog());
+    }
+}
+
+TEST_CASE("Searching the service catalog by name", "[search], [service_catalog]")
+{
+    SQLite_DB source(":memory:", "chocan_schema.sql");
+
+    Service_Catalog catalog(source.service_directory(), 1);
+
+    SECTION("Prefix search is case insensitive and matches any word")
+    {
+        auto matches = catalog.prefix_search("ADDICTION");
+
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].name() == "Addiction Consulting");
+        REQUIRE(matches[1].name() == "Addiction Treatment");
+
+        REQUIRE(catalog.prefix_search("rub").front().code() == 123456);
+        REQUIRE(catalog.prefix_search("back r").front().code() == 123456);
+    }
+    SECTION("Prefix search respects the limit")
+    {
+        REQUIRE(catalog.prefix_search("a", 1).size() == 1);
+    }
+    SECTION("Fuzzy search finds misspelled names")
+    {
+        REQUIRE(catalog.fuzzy_search("bak rubb").front().code() == 123456);
+        REQUIRE(catalog.fuzzy_search("dietician sesion").front().code() == 598470);
+        REQUIRE(catalog.fuzzy_search("zzzz").empty());
+    }
+    SECTION("Search returns prefix matches before fuzzy matches")
+    {
+        auto matches = catalog.search("group therapi");
+
+        REQUIRE_FALSE(matches.empty());
+        REQUIRE(matches.front().code() == 121121);
+    }
+    SECTION("Empty queries match nothing")
+    {
+        REQUIRE(catalog.search("  ").empty());
+    }
+}
@@ -0,0 +1,58 @@
+/*
+
+File: string_pool_tests.cpp
+
+Brief: Unit tests for the interned string pool
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <string>
+#include <catch.hpp>
+#include <ChocAn/core/utils/string_pool.hpp>
+
+TEST_CASE("Interning strings", "[string_pool]")
+{
+    String_Pool pool;
+
+    String_Pool::Handle portland = pool.intern("Portland");
+
+    SECTION("Equal strings share a handle")
+    {
+        REQUIRE(pool.intern(std::string("Portland")) == portland);
+        REQUIRE(pool.size() == 1);
+    }
+    SECTION("Distinct strings get distinct handles")
+    {
+        String_Pool::Handle salem = pool.intern("Salem");
+
+        REQUIRE(salem != portland);
+        REQUIRE(pool.at(salem) == "Salem");
+        REQUIRE(pool.at(portland) == "Portland");
+    }
+    SECTION("Handles stay valid as the pool grows")
+    {
+        const std::string& first = pool.at(portland);
+        for(int i = 0; i < 1000; ++i) { pool.intern(std::to_string(i)); }
+
+        REQUIRE(&pool.at(portland) == &first);
+        REQUIRE(pool.intern("Portland") == portland);
+    }
+    SECTION("A copy interns into its own strings")
+    {
+        String_Pool copy = pool;
+        pool = String_Pool();
+
+        REQUIRE(copy.intern("Portland") == portland);
+        REQUIRE(copy.size() == 1);
+        REQUIRE(pool.intern("Salem") == 0);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+
+File: tracer_tests.cpp
+
+Brief: Unit tests for the tracer and its chrome trace export
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/core/utils/tracer.hpp>
+
+TEST_CASE("Recording spans", "[span], [tracer]")
+{
+    Tracer tracer;
+
+    SECTION("A span records an event when it goes out of scope")
+    {
+        {
+            Tracer::Span span(&tracer, "Login", "state");
+
+            REQUIRE(tracer.events().empty());
+        }
+        REQUIRE(tracer.events().size() == 1);
+        REQUIRE(tracer.events().front().name == "Login");
+        REQUIRE(tracer.events().front().category == "state");
+        REQUIRE(tracer.events().front().duration >= 0);
+    }
+    SECTION("Nested spans are recorded innermost first and contained by the outer span")
+    {
+        {
+            Tracer::Span outer(&tracer, "outer", "state");
+            Tracer::Span inner(&tracer, "inner", "db");
+        }
+        auto events = tracer.events();
+
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].name == "inner");
+        REQUIRE(events[1].name == "outer");
+        REQUIRE(events[0].start >= events[1].start);
+        REQUIRE(events[0].start + events[0].duration <= events[1].start + events[1].duration);
+    }
+    SECTION("A span without a tracer is a no-op")
+    {
+        REQUIRE_NOTHROW(Tracer::Span(nullptr, "ignored", "state"));
+        REQUIRE(tracer.events().empty());
+    }
+}
+
+TEST_CASE("Exporting a chrome trace", "[chrome_trace], [tracer]")
+{
+    Tracer tracer;
+
+    SECTION("An empty tracer exports an empty event list")
+    {
+        REQUIRE(tracer.chrome_trace() == "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+    }
+    SECTION("Events are exported as complete events")
+    {
+        { Tracer::Span span(&tracer, "SELECT * FROM accounts;", "db"); }
+
+        std::string trace = tracer.chrome_trace();
+
+        REQUIRE(trace.find("\"name\":\"SELECT * FROM accounts;\"") != std::string::npos);
+        REQUIRE(trace.find("\"cat\":\"db\"") != std::string::npos);
+        REQUIRE(trace.find("\"ph\":\"X\"") != std::string::npos);
+        REQUIRE(trace.find("\"tid\":1") != std::string::npos);
+    }
+    SECTION("Names are escaped")
+    {
+        { Tracer::Span span(&tracer, "say \"hi\"\\\n", "view"); }
+
+        REQUIRE(tracer.chrome_trace().find("\"name\":\"say \\\"hi\\\"\\\\\\n\"") != std::string::npos);
+    }
+}
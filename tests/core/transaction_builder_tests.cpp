@@ -15,8 +15,11 @@ https://github.com/AlexanderJDupree/ChocAn
 */
 
 #include <stack>
+#include <cstdio>
 #include <catch.hpp>
 #include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/core/id_index.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
 #include <ChocAn/core/utils/transaction_builder.hpp>
 
 TEST_CASE("Setting Member Account Field", "[transaction_builder]")
@@ -122,6 +125,21 @@ TEST_CASE("Setting Service Field", "[transaction_builder]")
         builder.set_service_field("garbage");
         REQUIRE(builder.get_last_error().has_value());
     }
+    SECTION("Set Service Field accepts a unique partial or misspelled service name")
+    {
+        builder.set_service_field("back");
+        REQUIRE_FALSE(builder.get_last_error().has_value());
+
+        builder.set_service_field("bak rubb");
+        REQUIRE_FALSE(builder.get_last_error().has_value());
+    }
+    SECTION("Set Service Field offers every match when a service name is ambiguous")
+    {
+        builder.set_service_field("addiction");
+        REQUIRE(builder.get_last_error().has_value());
+        REQUIRE(builder.get_last_error().value().info().size() == 2);
+        REQUIRE(builder.get_last_error().value().info().count("111111"));
+    }
 }
 
 TEST_CASE("Setting Comments Field", "[transaction_builder]")
@@ -169,3 +187,93 @@ TEST_CASE("Building Transactions", "[transaction_builder]")
         REQUIRE_NOTHROW(builder.build());
     }
 }
+
+TEST_CASE("Entering a whole claim on one line", "[transaction_builder]")
+{
+    Data_Gateway::Database_Ptr db = std::make_unique<Mock_DB>();
+
+    Transaction_Builder builder(db);
+    builder.set_current_field("1234");
+
+    SECTION("A valid line fills every field at once")
+    {
+        builder.set_current_field("6789 | 10-10-2019 | Back Rub | sore | stiff");
+
+        REQUIRE_FALSE(builder.get_last_error().has_value());
+        REQUIRE(builder.buildable());
+        REQUIRE(builder.build().comments() == "sore | stiff");
+        REQUIRE(builder.build().service().code() == 123456);
+    }
+    SECTION("Comments may be left out")
+    {
+        builder.set_current_field("6789|10-10-2019|123456");
+
+        REQUIRE(builder.buildable());
+    }
+    SECTION("Every invalid field is reported together")
+    {
+        builder.set_current_field("9876|10-10-2999|123456|ok");
+
+        const auto& error = builder.get_last_error();
+        REQUIRE(error.has_value());
+        REQUIRE(error->info().count("Member ID"));
+        REQUIRE(error->info().count("Service Date"));
+        REQUIRE_FALSE(error->info().count("Service"));
+        REQUIRE(std::string(error->what()).find('2') == 0);
+    }
+    SECTION("Valid fields are kept and prompting resumes at the first missing one")
+    {
+        builder.set_current_field("6789|garbage||hello");
+
+        REQUIRE(builder.get_last_error()->info().count("Service"));
+        REQUIRE(std::holds_alternative<Transaction_Builder::Set_Service_Date>(builder.builder_state()));
+
+        builder.set_current_field("10-10-2019");
+        builder.set_current_field("123456");
+
+        REQUIRE(builder.buildable());
+        REQUIRE(builder.build().comments() == "hello");
+    }
+    SECTION("Fields can come from a form")
+    {
+        builder.set_fields({ { "Member ID", "6789" }, { "Service Date", "10-10-2019" }, { "Service", "123456" } });
+
+        REQUIRE(builder.buildable());
+    }
+    SECTION("A suspended member is turned away with the rest of the line valid")
+    {
+        builder.set_current_field("9876|10-10-2019|123456|ok");
+
+        REQUIRE(builder.get_last_error()->info().count("Member ID"));
+        REQUIRE_FALSE(builder.buildable());
+        REQUIRE(std::holds_alternative<Transaction_Builder::Set_Member_Acct>(builder.builder_state()));
+    }
+}
+
+TEST_CASE("Entering a claim for a member suspended by another connection", "[transaction_builder]")
+{
+    const char* file = "chocan_builder_test.db";
+    std::remove(file);
+
+    SQLite_DB(":memory:", "chocan_schema.sql").backup_to(file);
+    {
+        auto db = std::make_shared<SQLite_DB>(file);
+        REQUIRE(db->id_index().exists(123123123));
+
+        SQLite_DB other(file);
+        Account member = other.get_member_account(123123123).value();
+        REQUIRE(other.update_account(Account(member.name(), member.address(), Member(Account_Status::Suspended), member.id(), Mock_DB().get_db_key())));
+
+        // The index still has the member as valid, the account read for the claim does not
+        REQUIRE(db->member_status(123123123).value() == Account_Status::Valid);
+
+        Transaction_Builder builder(db);
+        builder.set_current_field("123451234");
+        builder.set_current_field("123123123|10-10-2019|123456|ok");
+
+        REQUIRE(builder.get_last_error()->info().count("Member ID"));
+        REQUIRE_FALSE(builder.buildable());
+        REQUIRE(std::holds_alternative<Transaction_Builder::Set_Member_Acct>(builder.builder_state()));
+    }
+    std::remove(file);
+}
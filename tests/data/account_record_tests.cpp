@@ -0,0 +1,74 @@
+/*
+
+File: account_record_tests.cpp
+
+Brief: Unit tests for the compact account records Memory_DB stores
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/account_record.hpp>
+
+TEST_CASE("Packing and unpacking account records", "[account_record]")
+{
+    Mock_DB     db;
+    String_Pool pool;
+
+    auto round_trip = [&](const Account& account)
+    {
+        return Account_Record(account, pool).unpack(pool, db.get_db_key());
+    };
+
+    SECTION("Every field survives a round trip")
+    {
+        Account member(Name("Danny", "Devito"), Address("1 Paddy st.", "Philadelphia", "pa", 19019),
+                       Member(Account_Status::Suspended), 1000, db.get_db_key());
+
+        Account copy = round_trip(member);
+
+        REQUIRE(copy.id() == 1000);
+        REQUIRE(copy.name() == member.name());
+        REQUIRE(copy.address() == member.address());
+        REQUIRE(std::get<Member>(copy.type()).status() == Account_Status::Suspended);
+    }
+    SECTION("Type and status are readable without unpacking")
+    {
+        Account_Record record(db.get_account(9876).value(), pool);
+
+        REQUIRE(record.id() == 9876);
+        REQUIRE(record.kind() == Codecs::Account_Kind::Member);
+        REQUIRE(record.status() == Account_Status::Suspended);
+        REQUIRE(Account_Record(db.get_account(5678).value(), pool).kind() == Codecs::Account_Kind::Manager);
+        REQUIRE(Account_Record(db.get_account(1234).value(), pool).kind() == Codecs::Account_Kind::Provider);
+    }
+    SECTION("Accounts on the same street share its name")
+    {
+        Account first(Name("A", "B"), Address("12 Main st.", "Portland", "OR", 97030), Provider(), 1, db.get_db_key());
+        Account second(Name("A", "C"), Address("340 Main st.", "Portland", "OR", 97030), Provider(), 2, db.get_db_key());
+
+        round_trip(first);
+        size_t pooled = pool.size();
+
+        REQUIRE(round_trip(second).address().street() == "340 Main st.");
+        REQUIRE(pool.size() == pooled + 1);
+    }
+    SECTION("Streets whose number would not print back the same are kept whole")
+    {
+        for(const char* street : { "0042 Main st.", "12345678901 Main", "12  Main", "12", "PO Box 7", "12B Main" })
+        {
+            Account account(Name("A", "B"), Address(street, "Portland", "OR", 97030), Provider(), 1, db.get_db_key());
+
+            REQUIRE(round_trip(account).address().street() == street);
+        }
+    }
+}
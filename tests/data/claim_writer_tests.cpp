@@ -0,0 +1,119 @@
+/*
+
+File: claim_writer_tests.cpp
+
+Brief: Unit tests for the group commit claim writer
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <set>
+#include <algorithm>
+#include <future>
+#include <vector>
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/data/claim_writer.hpp>
+
+TEST_CASE("Grouping claims into shared commits", "[claim_writer], [sqlite_db]")
+{
+    Mock_DB mock_db;
+    auto db = std::make_shared<SQLite_DB>(":memory:", "chocan_schema.sql");
+
+    auto claim = [&](int filed, int day = 23)
+    {
+        return Transaction( db->get_provider_account(123451234).value()
+                          , db->get_member_account(123123123).value()
+                          , db->lookup_service("123456").value()
+                          , DateTime( Day(day), Month(11), Year(2019))
+                          , DateTime(1600000000 + filed)
+                          , "comments"
+                          , mock_db.get_db_key() );
+    };
+
+    SECTION("Claims submitted within the window share one commit and each gets its own ID")
+    {
+        Claim_Writer writer(db, std::chrono::milliseconds(50));
+
+        std::vector<std::future<unsigned>> ids;
+        for(int i = 0; i < 5; ++i) { ids.push_back(writer.submit(claim(i))); }
+
+        unsigned last = 0;
+        for(auto& id : ids)
+        {
+            unsigned number = id.get();
+            REQUIRE(number > last);
+            last = number;
+        }
+
+        REQUIRE(writer.stats().claims  == 5);
+        REQUIRE(writer.stats().commits == 1);
+    }
+    SECTION("Claims filed within the same second all commit")
+    {
+        Claim_Writer writer(db, std::chrono::milliseconds(50));
+
+        std::vector<std::future<unsigned>> ids;
+        for(int day = 20; day < 25; ++day) { ids.push_back(writer.submit(claim(0, day))); }
+
+        std::set<unsigned> numbers;
+        for(auto& id : ids) { numbers.insert(id.get()); }
+
+        REQUIRE(numbers.size() == 5);
+        REQUIRE(numbers.count(0) == 0);
+
+        Data_Gateway::Transactions stored = db->get_transactions(DateTime(Day(20), Month(11), Year(2019)), DateTime(Day(25), Month(11), Year(2019)));
+        REQUIRE(std::count_if(stored.begin(), stored.end(), [](const Transaction& transaction)
+        {
+            return transaction.filed_date().unix_timestamp() == 1600000000;
+        } ) == 5);
+        REQUIRE(writer.stats().commits == 1);
+    }
+    SECTION("A failed claim does not fail the rest of its group")
+    {
+        Claim_Writer writer(db, std::chrono::milliseconds(50));
+
+        auto first     = writer.submit(claim(0));
+        auto duplicate = writer.submit(claim(0));
+        auto last      = writer.submit(claim(1));
+
+        REQUIRE(first.get() != 0);
+        REQUIRE(duplicate.get() == 0);
+        REQUIRE(last.get() != 0);
+    }
+    SECTION("Groups are capped at the maximum group size")
+    {
+        Claim_Writer writer(db, std::chrono::milliseconds(50), 2);
+
+        std::vector<std::future<unsigned>> ids;
+        for(int i = 0; i < 5; ++i) { ids.push_back(writer.submit(claim(i))); }
+        for(auto& id : ids) { id.get(); }
+
+        REQUIRE(writer.stats().largest == 2);
+        REQUIRE(writer.stats().commits == 3);
+    }
+    SECTION("Connections routed through the writer block until their claim commits")
+    {
+        auto writer = std::make_shared<Claim_Writer>(std::make_shared<SQLite_DB>(":memory:"), std::chrono::milliseconds(1));
+        Claim_Writer::Writer_Ptr none;
+
+        SQLite_DB session(":memory:", "chocan_schema.sql");
+        session.set_claim_writer(writer);
+
+        // The writer's connection has no schema, so the claim fails there rather than in session
+        REQUIRE(session.add_transaction(claim(0)) == 0);
+        REQUIRE(writer->stats().claims == 1);
+
+        session.set_claim_writer(none);
+        REQUIRE(session.add_transaction(claim(0)) != 0);
+    }
+}
@@ -0,0 +1,429 @@
+/*
+
+File: data_gateway_tests.cpp
+
+Brief: Unit tests every storage backend must pass, run against SQLite_DB, Memory_DB,
+       and Log_DB through the Data_Gateway interface
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <filesystem>
+#include <catch.hpp>
+#include <ChocAn/data/log_db.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/memory_db.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+
+namespace fs = std::filesystem;
+
+/*
+Each backend holds db, seeded with the dummy data of chocan_schema.sql, and empty, which
+has nothing loaded. In the dummy data:
+123456789 belongs to a manager account
+123123123 belongs to a member account
+123451234 belongs to a provider account
+*/
+
+class SQLite_Backend
+{
+public:
+
+    SQLite_DB db    { ":memory:", "chocan_schema.sql" };
+    SQLite_DB empty { ":memory:" };
+};
+
+class Memory_Backend
+{
+public:
+
+    Memory_Backend()
+    {
+        SQLite_DB source(":memory:", "chocan_schema.sql");
+        db.import(source);
+    }
+
+    Memory_DB db;
+    Memory_DB empty;
+};
+
+class Log_Backend
+{
+    // Removed once the logs in it are closed
+    struct Temp_Dir
+    {
+        explicit Temp_Dir(const std::string& name)
+            : path ( (fs::temp_directory_path() / name).string() )
+        {
+            fs::remove_all(path);
+        }
+
+        ~Temp_Dir() { fs::remove_all(path); }
+
+        std::string path;
+    };
+
+    Temp_Dir dir       { "chocan_gateway_test_log" };
+    Temp_Dir empty_dir { "chocan_gateway_test_empty_log" };
+
+public:
+
+    Log_Backend()
+    {
+        SQLite_DB source(":memory:", "chocan_schema.sql");
+        db.import(source);
+    }
+
+    Log_DB db    { dir.path };
+    Log_DB empty { empty_dir.path };
+};
+
+#define GATEWAY_TEST_CASE(name, tags) TEMPLATE_TEST_CASE(name, tags ", [data_gateway]", SQLite_Backend, Memory_Backend, Log_Backend)
+
+GATEWAY_TEST_CASE("Creating Accounts", "[create_account]")
+{
+    Mock_DB mock_db;
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    SECTION("Create_account returns true on success")
+    {
+        REQUIRE(db.create_account(mock_db.get_account("1234").value()));
+    }
+}
+
+GATEWAY_TEST_CASE("Deleting accounts", "[delete_account]")
+{
+    Mock_DB mock_db;
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    db.create_account(mock_db.get_account("1234").value());
+
+    SECTION("Delete accounts returns true when the operation succeeds")
+    {
+        REQUIRE(db.delete_account(1234));
+
+        SECTION("Deleted accounts ID's no longer exist in database")
+        {
+            REQUIRE_FALSE(db.id_exists(1234));
+        }
+    }
+}
+
+GATEWAY_TEST_CASE("Check if ID exists", "[id_exists]")
+{
+    Mock_DB mock_db;
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    SECTION("id_exists returns true if there is an account with the id")
+    {
+        Account test = mock_db.get_account(1234).value();
+
+        db.create_account(test);
+
+        REQUIRE(db.id_exists(test.id()));
+    }
+    SECTION("id_exists returns false if there is no account with the id")
+    {
+        REQUIRE_FALSE(db.id_exists(0));
+    }
+}
+
+GATEWAY_TEST_CASE("Looking up services in service directory", "[lookup_service]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    SECTION("Returns de-serialized service object when given a valid service code")
+    {
+        Service service = db.lookup_service(123456).value();
+
+        REQUIRE(service.code() == 123456);
+        REQUIRE(service.cost().value == 39.99);
+        REQUIRE(service.name() == "Back Rub");
+    }
+    SECTION("Returns None when given an invalid_service code")
+    {
+        REQUIRE_FALSE(db.lookup_service(0));
+    }
+}
+
+GATEWAY_TEST_CASE("Retrieving accounts from the database", "[get_account]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    SECTION("Retrieve accounts returns a filled optional object on success")
+    {
+        REQUIRE(db.get_account(123456789));
+    }
+    SECTION("Retrieival fails if account does not exist")
+    {
+        REQUIRE_FALSE(db.get_account("000"));
+    }
+    SECTION("Retrieval fails if the ID string is not convertible to int")
+    {
+        REQUIRE_FALSE(db.get_account("garbage"));
+    }
+    SECTION("Retrieval of a member account")
+    {
+        REQUIRE(db.get_member_account(123123123));
+    }
+    SECTION("Member account retrieval fails when given a non member ID")
+    {
+        REQUIRE_FALSE(db.get_member_account("123456789"));
+    }
+    SECTION("Retrieval of a provider account")
+    {
+        REQUIRE(db.get_provider_account(123451234));
+    }
+    SECTION("Member account retrieval fails when given a non provider ID")
+    {
+        REQUIRE_FALSE(db.get_provider_account("123456789"));
+    }
+    SECTION("Retrieval of a manager account")
+    {
+        REQUIRE(db.get_manager_account(123456789));
+    }
+    SECTION("Member account retrieval fails when given a non manager ID")
+    {
+        REQUIRE_FALSE(db.get_manager_account("123123123"));
+    }
+}
+
+GATEWAY_TEST_CASE("Add transactions to database", "[add_transaction]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    Transaction transaction ( db.get_provider_account(123451234).value()
+                            , db.get_member_account(123123123).value()
+                            , DateTime( Day(23), Month(11), Year(2019))
+                            , db.lookup_service("123456").value()
+                            , "comments" );
+
+    SECTION("add transaction returns the transaction ID on success")
+    {
+        REQUIRE(db.add_transaction(transaction) != 0);
+    }
+    SECTION("Add transaction returns 0 if the transaction ID already exists")
+    {
+        db.add_transaction(transaction);
+
+        REQUIRE(db.add_transaction(transaction) == 0);
+    }
+}
+
+GATEWAY_TEST_CASE("Retrieving the service directory", "[service_directory]")
+{
+    TestType backend;
+
+    SECTION("service directory returns a populated table on success")
+    {
+        REQUIRE_FALSE(backend.db.service_directory().empty());
+    }
+    SECTION("service directory returns an empty table from an empty database")
+    {
+        REQUIRE(backend.empty.service_directory().empty());
+    }
+}
+
+GATEWAY_TEST_CASE("Retrieving all Provider Accounts", "[get_provider_accounts]")
+{
+    TestType backend;
+
+    SECTION("get_provider_accounts from a populated db returns a non-empty list of all provider accounts")
+    {
+        REQUIRE(backend.db.get_provider_accounts().size() > 0);
+    }
+    SECTION("get_provider_accounts from an empty db returns a empty list")
+    {
+        REQUIRE(backend.empty.get_provider_accounts().empty());
+    }
+}
+
+GATEWAY_TEST_CASE("Retrieving Transaction data", "[get_transactions]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    Account member   = db.get_member_account(123123123).value();
+    Account provider = db.get_provider_account(987654321).value();
+    Account manager  = db.get_account(123456789).value();
+
+    SECTION("Retrieving all transactions from a populated DB returns a non-empty list of transactions")
+    {
+        REQUIRE(db.get_transactions(DateTime(0), DateTime::get_current_datetime()).size() > 0);
+    }
+    SECTION("If not transactions meet the date paramters the empty list is returnd")
+    {
+        REQUIRE(db.get_transactions(DateTime(0), DateTime(0)).empty());
+    }
+    SECTION("Providing a provider account will retrieve transactions relevant to that account")
+    {
+        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
+                                                                     , DateTime::get_current_datetime()
+                                                                     , provider );
+        REQUIRE_FALSE(transactions.empty());
+        for (const auto& transaction : transactions)
+        {
+            REQUIRE(transaction.provider() == provider);
+        }
+    }
+    SECTION("Providing a member account will retrieve transactions relevant to that account")
+    {
+        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
+                                                                     , DateTime::get_current_datetime()
+                                                                     , member );
+        REQUIRE_FALSE(transactions.empty());
+        for (const auto& transaction : transactions)
+        {
+            REQUIRE(transaction.member() == member);
+        }
+    }
+    SECTION("Providing a manager account will retrieve all transactions")
+    {
+        Data_Gateway::Transactions all_transactions = db.get_transactions( DateTime(0)
+                                                                         , DateTime::get_current_datetime() );
+
+        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
+                                                                     , DateTime::get_current_datetime()
+                                                                     , manager );
+        REQUIRE(all_transactions.size() == transactions.size());
+    }
+}
+
+GATEWAY_TEST_CASE("Scanning accounts and transactions with cursors", "[scan]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    SECTION("Account cursors page through accounts of one type in ID order")
+    {
+        Data_Gateway::Account_Cursor cursor = db.scan_provider_accounts();
+        cursor.set_batch_size(2);
+
+        std::vector<unsigned> ids;
+        for(const Account& account : cursor) { ids.push_back(account.id()); }
+
+        REQUIRE(ids == std::vector<unsigned> { 123451234, 177607040, 987654321 });
+        REQUIRE(db.scan_manager_accounts().drain().size() == 1);
+    }
+    SECTION("Transaction cursors return the same rows as get_transactions, ordered by service date")
+    {
+        DateTime start(0), end = DateTime::get_current_datetime();
+
+        Data_Gateway::Transaction_Cursor cursor = db.scan_transactions(start, end);
+        cursor.set_batch_size(2);
+
+        Data_Gateway::Transactions scanned = cursor.drain();
+
+        REQUIRE(scanned.size() == db.get_transactions(start, end).size());
+        for(size_t i = 1; i < scanned.size(); ++i)
+        {
+            REQUIRE(scanned[i - 1].service_date().unix_timestamp() <= scanned[i].service_date().unix_timestamp());
+        }
+
+        Account member = db.get_account(123123123).value();
+        REQUIRE(db.scan_transactions(start, end, member).drain().size() == db.get_transactions(start, end, member).size());
+    }
+}
+
+GATEWAY_TEST_CASE("Projecting rows to summaries and headers", "[projections]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    DateTime start(0), end = DateTime::get_current_datetime();
+
+    SECTION("Transaction summaries total the same as get_transactions, ordered by service date")
+    {
+        Data_Gateway::Transactions          transactions = db.get_transactions(start, end);
+        Data_Gateway::Transaction_Summaries summaries    = db.transaction_summaries(start, end);
+
+        double expected = 0, total = 0;
+        for(const Transaction& transaction : transactions) { expected += transaction.service().cost().value; }
+        for(const auto& summary : summaries) { total += summary.cost; }
+
+        REQUIRE(summaries.size() == transactions.size());
+        REQUIRE(total == Approx(expected));
+        for(size_t i = 1; i < summaries.size(); ++i)
+        {
+            REQUIRE(summaries[i - 1].service_date <= summaries[i].service_date);
+        }
+    }
+    SECTION("Account headers carry the ID, type, and status of an account")
+    {
+        REQUIRE(db.account_header(321321321).value().kind == Codecs::Account_Kind::Member);
+        REQUIRE(db.account_header(321321321).value().status == Account_Status::Suspended);
+        REQUIRE(db.account_header(123451234).value().kind == Codecs::Account_Kind::Provider);
+        REQUIRE_FALSE(db.account_header(42));
+    }
+    SECTION("Header cursors page through every account in ID order")
+    {
+        Data_Gateway::Header_Cursor cursor = db.scan_account_headers();
+        cursor.set_batch_size(3);
+
+        std::vector<unsigned> ids;
+        for(const Data_Gateway::Account_Header& header : cursor) { ids.push_back(header.id); }
+
+        REQUIRE(ids == std::vector<unsigned> { 123123123, 123412345, 123451234, 123456789
+                                             , 177607040, 321321321, 987654321 });
+    }
+}
+
+GATEWAY_TEST_CASE("Reading claims whose accounts are gone", "[projections], [delete_account]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    DateTime start(0), end = DateTime::get_current_datetime();
+
+    Account provider = db.get_provider_account(123451234).value();
+
+    REQUIRE(db.delete_account(123123123));
+
+    SECTION("Claims whose member is gone are left out of transactions and summaries")
+    {
+        REQUIRE(db.get_transactions(start, end).size() == 1);
+        REQUIRE(db.transaction_summaries(start, end).size() == 1);
+        REQUIRE(db.scan_transactions(start, end).drain().size() == 1);
+    }
+    SECTION("They are left out of their provider's transactions too")
+    {
+        REQUIRE(db.get_transactions(start, end, provider).empty());
+        REQUIRE(db.scan_transactions(start, end, provider).drain().empty());
+    }
+}
+
+GATEWAY_TEST_CASE("Tracing store operations", "[tracer]")
+{
+    TestType backend;
+    Data_Gateway& db = backend.db;
+
+    auto tracer = std::make_shared<Tracer>();
+    db.set_tracer(tracer);
+
+    SECTION("Reads made through the gateway are recorded as db spans")
+    {
+        db.get_transactions(DateTime(0), DateTime::get_current_datetime());
+
+        std::vector<Tracer::Event> events = tracer->events();
+
+        REQUIRE_FALSE(events.empty());
+        for(const Tracer::Event& event : events)
+        {
+            REQUIRE(event.category == std::string("db"));
+        }
+    }
+}
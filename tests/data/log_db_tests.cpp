@@ -0,0 +1,188 @@
+/*
+
+File: log_db_tests.cpp
+
+Brief: Unit tests for the log structured storage backend. The tests every backend
+       shares are in data_gateway_tests.cpp, these cover recovery and compaction.
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <fstream>
+#include <filesystem>
+#include <catch.hpp>
+#include <ChocAn/data/log_db.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+
+namespace fs = std::filesystem;
+
+// Creates an empty log directory that is removed when the test finishes
+struct Temp_Log_Dir
+{
+    Temp_Log_Dir()
+        : path ( (fs::temp_directory_path() / ("chocan_log_db_test_" + std::to_string(++count))).string() )
+    {
+        fs::remove_all(path);
+    }
+
+    ~Temp_Log_Dir() { fs::remove_all(path); }
+
+    // Log_DB seeded with the same dummy data as chocan_schema.sql
+    Log_DB& seeded()
+    {
+        SQLite_DB source(":memory:", "chocan_schema.sql");
+
+        db = std::make_unique<Log_DB>(path);
+        db->import(source);
+        return *db;
+    }
+
+    size_t log_size(const std::string& name) const
+    {
+        size_t size = 0;
+        for(const auto& entry : fs::directory_iterator(path))
+        {
+            if(entry.path().filename().string().compare(0, name.length(), name) == 0) { size += entry.file_size(); }
+        }
+        return size;
+    }
+
+    std::string path;
+    std::unique_ptr<Log_DB> db;
+
+    static inline unsigned count = 0;
+};
+
+TEST_CASE("Constructing Log_DB object", "[constructors], [log_db]")
+{
+    Temp_Log_Dir dir;
+
+    SECTION("Log_DB creates its log directory")
+    {
+        REQUIRE_NOTHROW( Log_DB(dir.path) );
+        REQUIRE(fs::is_directory(dir.path));
+    }
+    SECTION("Log_DB does throw when the log directory cannot be created")
+    {
+        REQUIRE_THROWS_AS( Log_DB("/dev/null/chocan"), chocan_db_exception );
+    }
+}
+
+TEST_CASE("Seeding Log_DB from another gateway", "[import], [log_db]")
+{
+    Temp_Log_Dir dir;
+    SQLite_DB source(":memory:", "chocan_schema.sql");
+
+    Log_DB db(dir.path, Log_DB::Sync_Policy::Always);
+    db.import(source);
+
+    SECTION("Imported records are written to the logs before import returns")
+    {
+        REQUIRE(dir.log_size("accounts") > 0);
+        REQUIRE(dir.log_size("claims") > 0);
+
+        Log_DB reader(dir.path);
+
+        REQUIRE(reader.account_count() == db.account_count());
+        REQUIRE(reader.transaction_count() == db.transaction_count());
+        REQUIRE(reader.service_directory().size() == db.service_directory().size());
+    }
+    SECTION("Writes after an import follow the sync policy again")
+    {
+        REQUIRE(db.create_account(Mock_DB().get_account(1234).value()));
+
+        REQUIRE(Log_DB(dir.path).get_provider_account(1234));
+    }
+}
+
+TEST_CASE("Recovering Log_DB state from its log", "[recovery], [log_db]")
+{
+    Temp_Log_Dir dir;
+    Log_DB& db = dir.seeded();
+
+    Mock_DB mock_db;
+    db.create_account(mock_db.get_account(1234).value());
+    db.delete_account(123451234);
+
+    size_t accounts     = db.account_count();
+    size_t transactions = db.transaction_count();
+
+    SECTION("Reopening the log rebuilds the same index")
+    {
+        dir.db.reset();
+
+        Log_DB reopened(dir.path);
+
+        REQUIRE(reopened.account_count() == accounts);
+        REQUIRE(reopened.transaction_count() == transactions);
+        REQUIRE(reopened.get_provider_account(1234));
+        REQUIRE_FALSE(reopened.id_exists(123451234));
+        REQUIRE(reopened.lookup_service(123456).value().cost().value == 39.99);
+    }
+    SECTION("A torn record at the tail of the log is discarded")
+    {
+        dir.db.reset();
+
+        size_t claims = dir.log_size("claims");
+        {
+            std::ofstream tail(dir.path + "/claims-00000001.log", std::ios::binary | std::ios::app);
+            tail << "\x40\x00\x00\x00garbage";
+        }
+
+        Log_DB reopened(dir.path);
+
+        REQUIRE(reopened.transaction_count() == transactions);
+        REQUIRE(dir.log_size("claims") == claims);
+    }
+}
+
+TEST_CASE("Compacting the Log_DB account log", "[compact], [log_db]")
+{
+    Temp_Log_Dir dir;
+    Log_DB& db = dir.seeded();
+
+    Account account = db.get_account(123456789).value();
+    for(int i = 0; i < 100; ++i) { db.update_account(account); }
+
+    REQUIRE(db.dead_records() == 100);
+
+    SECTION("Compaction drops superseded records and keeps live ones")
+    {
+        size_t before   = dir.log_size("accounts");
+        size_t services = db.service_directory().size();
+
+        REQUIRE(db.compact());
+        REQUIRE(db.dead_records() == 0);
+        REQUIRE(dir.log_size("accounts") < before);
+
+        dir.db.reset();
+
+        Log_DB reopened(dir.path);
+
+        REQUIRE(reopened.get_manager_account(123456789));
+        REQUIRE(reopened.service_directory().size() == services);
+        REQUIRE(reopened.dead_records() == 0);
+    }
+    SECTION("Accounts written after compaction survive a restart")
+    {
+        db.compact();
+
+        Mock_DB mock_db;
+        db.create_account(mock_db.get_account(1234).value());
+        dir.db.reset();
+
+        Log_DB reopened(dir.path);
+
+        REQUIRE(reopened.get_provider_account(1234));
+        REQUIRE(reopened.get_manager_account(123456789));
+    }
+}
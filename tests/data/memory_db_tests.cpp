@@ -0,0 +1,315 @@
+/*
+
+File: memory_db_tests.cpp
+
+Brief: Unit tests for the in memory storage engine
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/core/id_index.hpp>
+#include <ChocAn/data/memory_db.hpp>
+
+TEST_CASE("Updating accounts in Memory_DB", "[update_account], [memory_db]")
+{
+    Mock_DB db;
+
+    SECTION("Accounts are indexed by their type")
+    {
+        REQUIRE(db.get_provider_account(1234));
+        REQUIRE_FALSE(db.get_member_account(1234));
+        REQUIRE(db.get_member_account(6789));
+        REQUIRE_FALSE(db.get_provider_account(6789));
+        REQUIRE(db.get_manager_account("5678"));
+    }
+    SECTION("Updating an existing account replaces it")
+    {
+        Account provider(Name("Arman", "Renamed"), Address("1234 lame st.", "Portland", "OR", 97030), Provider(), 1234, db.get_db_key());
+
+        REQUIRE(db.update_account(provider));
+        REQUIRE(db.get_account(1234).value().name().last() == "Renamed");
+        REQUIRE(db.get_provider_accounts().size() == 2);
+    }
+    SECTION("Changing an accounts type moves it between type indexes")
+    {
+        Account member(Name("Arman", "Provider"), Address("1234 lame st.", "Portland", "OR", 97030), Member(), 1234, db.get_db_key());
+
+        db.update_account(member);
+
+        REQUIRE(db.get_member_account(1234));
+        REQUIRE_FALSE(db.get_provider_account(1234));
+        REQUIRE(db.get_provider_accounts().size() == 1);
+        REQUIRE(db.get_member_accounts().size() == 3);
+    }
+    SECTION("Creating an account with an existing ID fails")
+    {
+        REQUIRE(db.create_account(db.get_account(1234).value()) == 0);
+    }
+    SECTION("Deleted accounts are removed from every index")
+    {
+        REQUIRE(db.delete_account(1111));
+        REQUIRE_FALSE(db.id_exists(1111));
+        REQUIRE_FALSE(db.get_provider_account(1111));
+        REQUIRE(db.get_provider_accounts().size() == 1);
+        REQUIRE_FALSE(db.delete_account(1111));
+    }
+}
+
+TEST_CASE("Searching accounts by name and address", "[search_accounts], [memory_db]")
+{
+    Mock_DB db;
+
+    SECTION("Every term must prefix a word of the account's name or address")
+    {
+        REQUIRE(db.search_accounts("portland", 10).size() == 4);
+        REQUIRE(db.search_accounts("PORT mem", 10).size() == 2);
+        REQUIRE(db.search_accounts("alex mem", 10).front().id() == 6789);
+        REQUIRE(db.search_accounts("los ang", 10).front().id() == 1111);
+        REQUIRE(db.search_accounts("portland angeles", 10).empty());
+    }
+    SECTION("Whole word matches rank above prefix matches")
+    {
+        Account danny(Name("Danny", "Devito"), Address("1 Paddy st.", "Philadelphia", "PA", 19019), Member(), 1000, db.get_db_key());
+        db.create_account(danny);
+
+        Data_Gateway::Accounts results = db.search_accounts("dan", 10);
+
+        REQUIRE(results.size() == 2);
+        REQUIRE(results[0].id() == 5678);
+        REQUIRE(results[1].id() == 1000);
+    }
+    SECTION("Results are limited")
+    {
+        REQUIRE(db.search_accounts("portland", 2).size() == 2);
+        REQUIRE(db.search_accounts("portland", 0).empty());
+    }
+    SECTION("Updated and deleted accounts are reindexed")
+    {
+        Account provider(Name("Arman", "Renamed"), Address("1234 lame st.", "Salem", "OR", 97301), Provider(), 1234, db.get_db_key());
+        db.update_account(provider);
+        db.delete_account(6789);
+
+        REQUIRE(db.search_accounts("renamed salem", 10).front().id() == 1234);
+        REQUIRE(db.search_accounts("arman portland", 10).empty());
+        REQUIRE(db.search_accounts("alex", 10).empty());
+    }
+    SECTION("Queries without words match nothing")
+    {
+        REQUIRE(db.search_accounts("  ,. ", 10).empty());
+    }
+}
+
+TEST_CASE("Querying transactions by service date", "[get_transactions], [memory_db]")
+{
+    Mock_DB db;
+
+    Account provider = db.get_provider_account(1111).value();
+    Account member   = db.get_member_account(6789).value();
+
+    SECTION("Range queries include both end points and are ordered by service date")
+    {
+        auto transactions = db.get_transactions(DateTime(1574480800), DateTime(1574680800));
+
+        REQUIRE(transactions.size() == 3);
+        REQUIRE(transactions[0].service_date() == DateTime(1574480800));
+        REQUIRE(transactions[1].service_date() == DateTime(1574580800));
+        REQUIRE(transactions[2].service_date() == DateTime(1574680800));
+    }
+    SECTION("Account queries only return that accounts transactions")
+    {
+        auto transactions = db.get_transactions(DateTime(0.0), DateTime::get_current_datetime(), provider);
+
+        REQUIRE(transactions.size() == 2);
+        REQUIRE(transactions[0].provider() == provider);
+        REQUIRE(transactions[1].provider() == provider);
+        REQUIRE(db.get_transactions(DateTime(0.0), DateTime::get_current_datetime(), member).size() == 4);
+    }
+    SECTION("Transactions added later are indexed")
+    {
+        db.add_transaction(Transaction(provider, member, DateTime(1574380800), db.lookup_service(111111).value(), ""));
+
+        REQUIRE(db.get_transactions(DateTime(1574380800), DateTime(1574380800)).size() == 2);
+        REQUIRE(db.get_transactions(DateTime(1574380800), DateTime(1574380800), provider).size() == 1);
+        REQUIRE(db.transaction_count() == 5);
+    }
+    SECTION("Managers have access to every transaction")
+    {
+        Account manager = db.get_manager_account(5678).value();
+
+        REQUIRE(db.get_transactions(DateTime(0.0), DateTime::get_current_datetime(), manager).size() == 4);
+    }
+    SECTION("Filing the same transaction twice fails")
+    {
+        Transaction transaction(provider, member, DateTime(1574380800), db.lookup_service(111111).value(), "");
+
+        REQUIRE(db.add_transaction(transaction) != 0);
+        REQUIRE(db.add_transaction(transaction) == 0);
+        REQUIRE(db.transaction_count() == 5);
+    }
+}
+
+TEST_CASE("Scanning Memory_DB with cursors", "[scan], [memory_db]")
+{
+    Mock_DB db;
+
+    SECTION("Accounts added while scanning are returned if their ID is past the cursor")
+    {
+        Data_Gateway::Account_Cursor cursor = db.scan_member_accounts();
+        cursor.set_batch_size(1);
+
+        REQUIRE(cursor.next().value().id() == 6789);
+
+        db.create_account(Account(Name("New", "Member"), Address("1 New st.", "Portland", "OR", 97030), Member(), 9999, db.get_db_key()));
+        db.create_account(Account(Name("Old", "Member"), Address("1 Old st.", "Portland", "OR", 97030), Member(), 1000, db.get_db_key()));
+
+        std::vector<unsigned> rest;
+        for(const Account& account : cursor) { rest.push_back(account.id()); }
+
+        REQUIRE(rest == std::vector<unsigned> { 9876, 9999 });
+    }
+    SECTION("Transaction cursors match get_transactions across batches")
+    {
+        DateTime start(0), end = DateTime::get_current_datetime();
+
+        Data_Gateway::Transaction_Cursor cursor = db.scan_transactions(start, end);
+        cursor.set_batch_size(1);
+
+        REQUIRE(cursor.drain().size() == db.get_transactions(start, end).size());
+        REQUIRE(db.scan_transactions(start, end, db.get_account(1234).value()).drain().size()
+                == db.get_transactions(start, end, db.get_account(1234).value()).size());
+    }
+}
+
+TEST_CASE("Projecting Memory_DB rows", "[projections], [memory_db]")
+{
+    Mock_DB db;
+
+    SECTION("Account headers merge every account type in ID order")
+    {
+        Data_Gateway::Header_Cursor cursor = db.scan_account_headers();
+        cursor.set_batch_size(2);
+
+        std::vector<unsigned> ids;
+        for(const Data_Gateway::Account_Header& header : cursor) { ids.push_back(header.id); }
+
+        REQUIRE(ids == std::vector<unsigned> { 1111, 1234, 5678, 6789, 9876 });
+        REQUIRE(db.account_header(9876).value().status == Account_Status::Suspended);
+        REQUIRE(db.account_header(5678).value().kind == Codecs::Account_Kind::Manager);
+        REQUIRE_FALSE(db.account_header(4242));
+    }
+    SECTION("Transaction summaries carry the keys and cost of each transaction")
+    {
+        DateTime start(0), end = DateTime::get_current_datetime();
+
+        Data_Gateway::Transactions        transactions = db.get_transactions(start, end);
+        Data_Gateway::Transaction_Summaries summaries  = db.transaction_summaries(start, end);
+
+        REQUIRE(summaries.size() == transactions.size());
+        for(size_t i = 0; i < summaries.size(); ++i)
+        {
+            REQUIRE(summaries[i].provider_id  == transactions[i].provider().id());
+            REQUIRE(summaries[i].service_code == transactions[i].service().code());
+            REQUIRE(summaries[i].cost         == transactions[i].service().cost().value);
+        }
+    }
+}
+
+TEST_CASE("Seeding Memory_DB from another gateway", "[constructors], [memory_db]")
+{
+    SQLite_DB source(":memory:", "chocan_schema.sql");
+
+    Memory_DB db(source);
+
+    SECTION("Every account, service, and transaction is copied")
+    {
+        REQUIRE(db.account_count() == source.get_member_accounts().size()
+                                    + source.get_provider_accounts().size()
+                                    + source.get_manager_accounts().size());
+        REQUIRE(db.service_directory().size() == source.service_directory().size());
+        REQUIRE(db.transaction_count() == source.get_transactions(DateTime(0.0), DateTime::get_current_datetime()).size());
+    }
+    SECTION("Seeded accounts keep their type")
+    {
+        REQUIRE(db.get_manager_account(123456789));
+        REQUIRE(db.get_member_account(123123123));
+        REQUIRE(db.get_provider_account(123451234));
+    }
+}
+
+TEST_CASE("Memory_DB snapshots", "[snapshot], [memory_db]")
+{
+    const char* snapshot = "chocan_snapshot_test.bin";
+    std::remove(snapshot);
+
+    Mock_DB db;
+
+    SECTION("A snapshot restores every account, service, and transaction")
+    {
+        REQUIRE(db.save_snapshot(snapshot));
+
+        Memory_DB restored;
+
+        REQUIRE(restored.load_snapshot(snapshot));
+        REQUIRE(restored.account_count() == db.account_count());
+        REQUIRE(restored.get_member_account(9876));
+        REQUIRE(restored.lookup_service(123456).value().cost().value == 29.99);
+        REQUIRE(restored.get_transactions(DateTime(0.0), DateTime::get_current_datetime()).size() == 4);
+        REQUIRE(restored.get_transactions(DateTime(0.0), DateTime::get_current_datetime(), db.get_account(1111).value()).size() == 2);
+    }
+    SECTION("Missing or corrupt snapshots are rejected")
+    {
+        Memory_DB restored;
+
+        REQUIRE_FALSE(restored.load_snapshot(snapshot));
+
+        db.save_snapshot(snapshot);
+        {
+            std::fstream file(snapshot, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(40);
+            file.put('X');
+        }
+        REQUIRE_FALSE(restored.load_snapshot(snapshot));
+    }
+    SECTION("A snapshot with a malformed record is rejected without changing the database")
+    {
+        using Record_Type = Record_Codec::Record_Type;
+
+        Memory_DB restored(db);
+        size_t accounts = restored.account_count();
+        {
+            std::ofstream file(snapshot, std::ios::binary);
+            file << Record_Codec::frame(Record_Type::Snapshot, "")
+                 << Record_Codec::frame(Record_Type::Account_Put, Record_Codec::encode(db.get_account(1234).value()))
+                 << Record_Codec::frame(Record_Type::Account_Put, Record_Codec::encode({ { "chocan_id", "garbage" } }));
+        }
+
+        REQUIRE_FALSE(restored.load_snapshot(snapshot));
+        REQUIRE(restored.account_count() == accounts);
+        REQUIRE(restored.get_member_account(9876));
+    }
+    SECTION("A snapshot replaces the contents and the ID index")
+    {
+        Memory_DB restored(db);
+        REQUIRE(restored.id_index().exists(9876));
+
+        REQUIRE(Memory_DB().save_snapshot(snapshot));
+        REQUIRE(restored.load_snapshot(snapshot));
+
+        REQUIRE(restored.account_count() == 0);
+        REQUIRE_FALSE(restored.id_index().exists(9876));
+    }
+    std::remove(snapshot);
+}
@@ -0,0 +1,134 @@
+/*
+
+File: query_metrics_tests.cpp
+
+Brief: Unit tests for query metrics and the sqlite_db slow query log
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <catch.hpp>
+#include <ChocAn/data/sqlite_db.hpp>
+#include <ChocAn/data/query_metrics.hpp>
+#include <ChocAn/core/entities/account.hpp>
+
+TEST_CASE("Normalizing queries into query shapes", "[normalize], [query_metrics]")
+{
+    SECTION("Numeric literals are replaced with placeholders")
+    {
+        REQUIRE(Query_Metrics::normalize("SELECT * FROM accounts WHERE chocan_id=123456789;")
+                == "SELECT * FROM accounts WHERE chocan_id=?;");
+    }
+    SECTION("String literals, including escaped quotes, are replaced with placeholders")
+    {
+        REQUIRE(Query_Metrics::normalize("SELECT * FROM accounts WHERE type='Member''s' and chocan_id=1;")
+                == "SELECT * FROM accounts WHERE type=? and chocan_id=?;");
+    }
+    SECTION("Digits within identifiers are preserved")
+    {
+        REQUIRE(Query_Metrics::normalize("SELECT col1 FROM t2 WHERE x = 3.5") == "SELECT col1 FROM t2 WHERE x = ?");
+    }
+    SECTION("Whitespace is collapsed")
+    {
+        REQUIRE(Query_Metrics::normalize("  SELECT *\n\tFROM   services  ") == "SELECT * FROM services");
+    }
+}
+
+TEST_CASE("Recording query stats", "[record], [query_metrics]")
+{
+    using std::chrono::microseconds;
+
+    Query_Metrics metrics;
+
+    metrics.record("SELECT * FROM services WHERE code=1;", microseconds(10), 1, true);
+    metrics.record("SELECT * FROM services WHERE code=2;", microseconds(30), 0, true);
+    metrics.record("SELECT * FROM nothing;", microseconds(5), 0, false);
+
+    SECTION("Queries with the same shape are aggregated")
+    {
+        REQUIRE(metrics.stats().size() == 2);
+
+        const Query_Metrics::Query_Stats& stats = metrics.stats().at("SELECT * FROM services WHERE code=?;");
+
+        REQUIRE(stats.calls == 2);
+        REQUIRE(stats.rows == 1);
+        REQUIRE(stats.errors == 0);
+        REQUIRE(stats.latency.max() == microseconds(30));
+    }
+    SECTION("Failed statements are counted as errors")
+    {
+        REQUIRE(metrics.stats().at("SELECT * FROM nothing;").errors == 1);
+    }
+    SECTION("Reset clears all stats")
+    {
+        metrics.reset();
+
+        REQUIRE(metrics.stats().empty());
+    }
+}
+
+TEST_CASE("Latency histogram percentiles", "[latency_histogram], [query_metrics]")
+{
+    using std::chrono::microseconds;
+
+    Latency_Histogram histogram;
+
+    for(int i = 1; i <= 1000; ++i) { histogram.record(microseconds(i)); }
+
+    SECTION("Percentiles are within the bucket resolution of the true value")
+    {
+        REQUIRE(histogram.percentile(50).count() >= 500);
+        REQUIRE(histogram.percentile(50).count() <= 500 * 1.125);
+        REQUIRE(histogram.percentile(99).count() >= 990);
+        REQUIRE(histogram.percentile(100) == microseconds(1000));
+    }
+    SECTION("Count, min and max are exact")
+    {
+        REQUIRE(histogram.count() == 1000);
+        REQUIRE(histogram.min() == microseconds(1));
+        REQUIRE(histogram.max() == microseconds(1000));
+    }
+}
+
+TEST_CASE("SQLite_DB records query metrics", "[query_metrics], [sqlite_db]")
+{
+    SQLite_DB db(":memory:", "chocan_schema.sql");
+
+    db.query_metrics().reset();
+
+    SECTION("Each executed statement is recorded under its shape")
+    {
+        db.get_account(123456789);
+        db.get_account(123123123);
+
+        const auto& stats = db.query_metrics().stats();
+
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats.begin()->second.calls == 2);
+        REQUIRE(stats.begin()->second.rows == 2);
+    }
+    SECTION("Statements over the slow query threshold are logged with their query plan")
+    {
+        db.query_metrics().set_slow_threshold(std::chrono::microseconds(0));
+
+        db.get_account(123456789);
+
+        REQUIRE(db.query_metrics().slow_log().size() == 1);
+        REQUIRE(db.query_metrics().slow_log().front().query_plan.find("accounts") != std::string::npos);
+    }
+    SECTION("Error messages from failed statements are retained")
+    {
+        SQLite_DB no_schema_db(":memory:");
+
+        REQUIRE(no_schema_db.get_provider_accounts().empty());
+        REQUIRE(no_schema_db.last_error().find("no such table") != std::string::npos);
+    }
+}
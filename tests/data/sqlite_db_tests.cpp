@@ -19,6 +19,7 @@ https://github.com/AlexanderJDupree/ChocAn
 #include <iostream>
 #include <catch.hpp>
 #include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/core/id_index.hpp>
 #include <ChocAn/data/sqlite_db.hpp>
 #include <ChocAn/core/entities/transaction.hpp>
 
@@ -42,220 +43,326 @@ TEST_CASE("Constructing SQLite_DB object", "[constructors], [sqlite_db]")
     }
 }
 
-TEST_CASE("Creating Accounts", "[create_account], [sqlite_db]")
+TEST_CASE("Searching accounts with the full text index", "[search_accounts], [sqlite_db]")
 {
-    Mock_DB mock_db;
     SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
 
-    SECTION("Create_account returns true on success")
+    SECTION("Every term must prefix a word of the account's name or address")
     {
-        REQUIRE(db.create_account(mock_db.get_account("1234").value()));
+        REQUIRE(db.search_accounts("doe", 10).size() == 2);
+        REQUIRE(db.search_accounts("john doe", 10).front().id() == 123123123);
+        REQUIRE(db.search_accounts("Mees", 10).size() == 2);
+        REQUIRE(db.search_accounts("springfield portland", 10).empty());
     }
-}
-
-TEST_CASE("Deleting accounts", "[delete_account], [sqlite_db]")
-{
-    Mock_DB mock_db;
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+    SECTION("Results are limited and quotes in the query are ignored")
+    {
+        REQUIRE(db.search_accounts("portland", 1).size() == 1);
+        REQUIRE(db.search_accounts("\"rick' sanchez", 10).front().id() == 987654321);
+    }
+    SECTION("The index is kept in sync as accounts are replaced and deleted")
+    {
+        Account rick = db.get_account(987654321).value();
+        Account moved(rick.name(), Address("1 Citadel way", "Citadel", "NJ", 86453), rick.type(), rick.id(), Mock_DB().get_db_key());
 
-    db.create_account(mock_db.get_account("1234").value());
+        REQUIRE(db.update_account(moved));
+        REQUIRE(db.search_accounts("citadel", 10).front().id() == 987654321);
+        REQUIRE(db.search_accounts("rick meeseeks", 10).empty());
 
-    SECTION("Delete accounts returns true when the operation succeeds")
+        REQUIRE(db.delete_account(987654321));
+        REQUIRE(db.search_accounts("rick", 10).empty());
+    }
+    SECTION("A database without the index returns no results")
     {
-        REQUIRE(db.delete_account(1234));
+        SQLite_DB empty_db(TEST_DB);
 
-        SECTION("Deleted accounts ID's no longer exist in database")
-        {
-            REQUIRE_FALSE(db.id_exists(1234));
-        }
+        REQUIRE(empty_db.search_accounts("doe", 10).empty());
     }
 }
 
-TEST_CASE("Check if ID exists", "[id_exists], [sqlite_db]")
+TEST_CASE("Skipping rows that cannot be decoded", "[malformed_rows], [sqlite_db]")
 {
-    Mock_DB mock_db;
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+    const char* file = "chocan_malformed_test.db";
+    std::remove(file);
 
-    SECTION("id_exists returns true if there is an account with the id")
+    SQLite_DB(TEST_DB, CHOCAN_SCHEMA).backup_to(file);
     {
-        Account test = mock_db.get_account(1234).value();
+        sqlite3* raw = nullptr;
+        sqlite3_open(file, &raw);
+        int rc = sqlite3_exec(raw, "INSERT INTO accounts VALUES (555555555, 'Bad', 'Zip', '1 Nowhere St', 'Portland', 'OR', 'abc', 'Member', 'Valid');"
+                                   "INSERT INTO services VALUES (999999, 'free', 'Bad Cost');", nullptr, nullptr, nullptr);
+        sqlite3_close(raw);
 
-        db.create_account(test);
+        REQUIRE(rc == SQLITE_OK);
+    }
+
+    SQLite_DB db(file);
+    const Query_Metrics::Malformed_Table& malformed = db.query_metrics().malformed_rows();
 
-        REQUIRE(db.id_exists(test.id()));
+    SECTION("Malformed accounts are not returned and are counted")
+    {
+        REQUIRE_FALSE(db.get_account(555555555));
+        REQUIRE(db.scan_member_accounts().drain().size() == 3);
+        REQUIRE(db.search_accounts("zip", 10).empty());
+        REQUIRE(malformed.at("accounts") == 3);
     }
-    SECTION("id_exists returns false if there is no account with the id")
+    SECTION("Malformed services are not returned and are counted")
     {
-        REQUIRE_FALSE(db.id_exists(0));
+        REQUIRE_FALSE(db.lookup_service(999999));
+        REQUIRE(db.service_directory().count(999999) == 0);
+        REQUIRE_FALSE(db.service_directory().empty());
+        REQUIRE(malformed.at("services") == 3);
     }
+    std::remove(file);
 }
 
-TEST_CASE("Looking up services in service directory", "[lookup_service], [sqlite_db]")
+TEST_CASE("Migrating databases made by an older schema", "[migration], [sqlite_db]")
 {
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+    const char* file = "chocan_migration_test.db";
+    std::remove(file);
 
-    SECTION("Returns de-serialized service object when given a valid service code")
+    SQLite_DB(TEST_DB, CHOCAN_SCHEMA).backup_to(file);
+
+    // Rewinds the file to the layout keyed by filed_date
+    auto rewind = [&](const std::string& extra)
+    {
+        sqlite3* old = nullptr;
+        sqlite3_open(file, &old);
+        int rc = sqlite3_exec(old, ( "ALTER TABLE transactions RENAME TO transactions_v1;"
+                                     "CREATE TABLE transactions ( service_date INTEGER NOT NULL, filed_date INTEGER NOT NULL,"
+                                     " provider_id INTEGER NOT NULL, member_id INTEGER NOT NULL, service_code INTEGER NOT NULL,"
+                                     " comments TEXT, PRIMARY KEY(filed_date) );"
+                                     "INSERT INTO transactions SELECT service_date, filed_date, provider_id, member_id, service_code, comments"
+                                     " FROM transactions_v1;"
+                                     "DROP TABLE transactions_v1;"
+                                     "CREATE INDEX transactions_service_date ON transactions (service_date, filed_date);"
+                                     "PRAGMA user_version = 0;" + extra ).c_str(), nullptr, nullptr, nullptr);
+        sqlite3_close(old);
+
+        REQUIRE(rc == SQLITE_OK);
+    };
+
+    DateTime start(0), end = DateTime::get_current_datetime();
+
+    SECTION("Opening the database rebuilds the transactions table with its rows")
     {
-        // Chocan schema provides default data for service 123456
-        Service service = db.lookup_service(123456).value();
+        rewind("");
+
+        SQLite_DB db(file);
+
+        REQUIRE(db.get_transactions(start, end).size() == 5);
+        REQUIRE(db.scan_transactions(start, end).drain().size() == 5);
 
-        REQUIRE(service.code() == 123456);
-        REQUIRE(service.cost().value == 39.99);
-        REQUIRE(service.name() == "Back Rub");
+        auto claim = [&](int day)
+        {
+            return Transaction( db.get_provider_account(123451234).value()
+                              , db.get_member_account(123123123).value()
+                              , db.lookup_service("123456").value()
+                              , DateTime(Day(day), Month(11), Year(2019))
+                              , end
+                              , "comments"
+                              , Mock_DB().get_db_key() );
+        };
+        REQUIRE(db.add_transaction(claim(20)) > 5);
+        REQUIRE(db.add_transaction(claim(21)) > 5);
     }
-    SECTION("Returns None when given an invalid_service code")
+    SECTION("Partitioned databases are rejected rather than opened half migrated")
     {
-        REQUIRE_FALSE(db.lookup_service(0));
+        rewind("CREATE TABLE transaction_partitions ( month INTEGER PRIMARY KEY );");
+
+        REQUIRE_THROWS_AS(SQLite_DB(file), chocan_db_exception);
     }
+    std::remove(file);
 }
 
-TEST_CASE("Retrieving accounts from the database", "[get_account], [sqlite_db]")
+TEST_CASE("Backing up and restoring database images", "[backup], [sqlite_db]")
 {
-    /* 
-    Note: chocan_schema.sql comes with dummy data. 
-    123456789 belongs to a manager account
-    123123123 belongs to a member account
-    123451234 belongs to a provider account
-    */
-    
+    const char* image = "chocan_backup_test.db";
+    std::remove(image);
+
     SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
 
-    SECTION("Retrieve accounts returns a filled optional object on success")
-    {
-        REQUIRE(db.get_account(123456789));
-    }
-    SECTION("Retrieival fails if account does not exist")
+    SECTION("A backup can be restored into an empty in memory database")
     {
-        REQUIRE_FALSE(db.get_account("000"));
+        REQUIRE(db.backup_to(image));
+        REQUIRE(SQLite_DB::is_database_image(image));
+
+        SQLite_DB restored(TEST_DB);
+
+        REQUIRE(restored.restore_from(image));
+        REQUIRE(restored.get_manager_account(123456789));
+        REQUIRE(restored.service_directory().size() == db.service_directory().size());
+        REQUIRE(restored.get_transactions(DateTime(0), DateTime::get_current_datetime()).size()
+                == db.get_transactions(DateTime(0), DateTime::get_current_datetime()).size());
     }
-    SECTION("Retrieval fails if the ID string is not convertible to int")
+    SECTION("Restoring from a missing image fails")
     {
-        REQUIRE_FALSE(db.get_account("garbage"));
+        SQLite_DB restored(TEST_DB);
+
+        REQUIRE_FALSE(restored.restore_from(image));
+        REQUIRE_FALSE(SQLite_DB::is_database_image(image));
+        REQUIRE_FALSE(SQLite_DB::is_database_image(CHOCAN_SCHEMA));
     }
-    SECTION("Retrieval of a member account")
+    std::remove(image);
+}
+
+TEST_CASE("Partitioning transactions by month", "[partitions], [sqlite_db]")
+{
+    const char* archive = "chocan_partition_test.db";
+    std::remove(archive);
+
+    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+
+    DateTime start(0), end = DateTime::get_current_datetime();
+    size_t total = db.get_transactions(start, end).size();
+
+    REQUIRE(db.transaction_partitions().empty());
+    REQUIRE(db.partition_transactions());
+
+    Transaction november ( db.get_provider_account(123451234).value()
+                         , db.get_member_account(123123123).value()
+                         , DateTime( Day(23), Month(11), Year(2019))
+                         , db.lookup_service("123456").value()
+                         , "comments" );
+
+    SECTION("Partitioning moves the transactions into one partition per month")
     {
-        REQUIRE(db.get_member_account(123123123));
+        std::vector<SQLite_DB::Partition> partitions = db.transaction_partitions();
+
+        REQUIRE(partitions.size() == 2);
+        REQUIRE(partitions[0].month == 201911);
+        REQUIRE(partitions[1].month == 201912);
+        REQUIRE(partitions[0].end_date == partitions[1].first_date);
+        REQUIRE(total == 5);
     }
-    SECTION("Member account retrieval fails when given a non member ID")
+    SECTION("Range queries only return rows of the overlapping partitions")
     {
-        REQUIRE_FALSE(db.get_member_account("123456789"));
+        REQUIRE(db.get_transactions(DateTime(Day(1), Month(12), Year(2019)), end).size() == 2);
+        REQUIRE(db.scan_transactions(DateTime(Day(1), Month(12), Year(2019)), end).drain().size() == 2);
+        REQUIRE(db.get_transactions(start, DateTime(Day(1), Month(11), Year(2019))).empty());
     }
-    SECTION("Retrieval of a provider account")
+    SECTION("Transactions of a new month create its partition")
     {
-        REQUIRE(db.get_provider_account(123451234));
+        Transaction january ( db.get_provider_account(123451234).value()
+                            , db.get_member_account(123123123).value()
+                            , DateTime( Day(15), Month(1), Year(2020))
+                            , db.lookup_service("123456").value()
+                            , "comments" );
+
+        REQUIRE(db.add_transaction(january) != 0);
+        REQUIRE(db.transaction_partitions().back().month == 202001);
+        REQUIRE(db.get_transactions(start, end).size() == total + 1);
     }
-    SECTION("Member account retrieval fails when given a non provider ID")
+    SECTION("Claims filed within the same second into different months get distinct IDs")
     {
-        REQUIRE_FALSE(db.get_provider_account("123456789"));
+        auto claim = [&](const DateTime& service_date)
+        {
+            return Transaction( db.get_provider_account(123451234).value()
+                              , db.get_member_account(123123123).value()
+                              , db.lookup_service("123456").value()
+                              , service_date
+                              , end
+                              , "comments"
+                              , Mock_DB().get_db_key() );
+        };
+
+        unsigned in_november = db.add_transaction(claim(DateTime(Day(24), Month(11), Year(2019))));
+        unsigned in_december = db.add_transaction(claim(DateTime(Day(24), Month(12), Year(2019))));
+
+        // The schema's transactions hold IDs 1 through total, spread over both months
+        REQUIRE(in_november > total);
+        REQUIRE(in_december > total);
+        REQUIRE(in_november != in_december);
+        REQUIRE(db.get_transactions(start, end).size() == total + 2);
+
+        REQUIRE(db.add_transaction(claim(DateTime(Day(24), Month(11), Year(2019)))) == 0);
     }
-    SECTION("Retrieval of a manager account")
+    SECTION("Sealed partitions keep their rows and reject new ones")
     {
-        REQUIRE(db.get_manager_account(123456789));
+        REQUIRE(db.seal_partitions(DateTime(Day(1), Month(12), Year(2019))) == 1);
+        REQUIRE(db.transaction_partitions()[0].sealed);
+        REQUIRE_FALSE(db.transaction_partitions()[1].sealed);
+
+        REQUIRE(db.add_transaction(november) == 0);
+        REQUIRE(db.get_transactions(start, end).size() == total);
     }
-    SECTION("Member account retrieval fails when given a non manager ID")
+    SECTION("Archived partitions are read from their file until detached")
     {
-        REQUIRE_FALSE(db.get_manager_account("123123123"));
-    }
-}
+        REQUIRE_FALSE(db.archive_partition(201911, archive));
 
-TEST_CASE("Add transactions to database", "[add_transaction], [sqlite_db]")
-{
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+        db.seal_partitions(DateTime(Day(1), Month(12), Year(2019)));
 
-    Transaction transaction ( db.get_provider_account(123451234).value()
-                            , db.get_member_account(123123123).value()
-                            , DateTime( Day(23), Month(11), Year(2019))
-                            , db.lookup_service("123456").value()
-                            , "comments" );
+        REQUIRE(db.archive_partition(201911, archive));
+        REQUIRE(db.transaction_partitions()[0].file == archive);
+        REQUIRE(db.get_transactions(start, end).size() == total);
+        REQUIRE(db.scan_transactions(start, end).drain().size() == total);
+        REQUIRE(db.add_transaction(november) == 0);
 
-    SECTION("add transaction returns the transaction ID on success")
-    {
-        REQUIRE(db.add_transaction(transaction) != 0);
+        REQUIRE(db.detach_partition(201911));
+        REQUIRE(db.get_transactions(start, end).size() == total - 3);
+
+        REQUIRE(db.attach_partition(archive));
+        REQUIRE(db.get_transactions(start, end).size() == total);
     }
-    SECTION("Add transaction returns 0 if the transaction ID already exists")
+    SECTION("Databases without a transactions table cannot be partitioned")
     {
-        db.add_transaction(transaction);
+        SQLite_DB no_schema_db(TEST_DB);
 
-        REQUIRE(db.add_transaction(transaction) == 0);
+        REQUIRE_FALSE(no_schema_db.partition_transactions());
+        REQUIRE(no_schema_db.transaction_partitions().empty());
     }
+    std::remove(archive);
 }
 
-TEST_CASE("Retrieving the service directory", "[service_directory], [sqlite_db]")
+TEST_CASE("Keeping the ID index current across connections", "[id_index], [sqlite_db]")
 {
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
-    SQLite_DB no_schema_db(TEST_DB);
+    const char* file = "chocan_id_index_test.db";
+    std::remove(file);
 
-    SECTION("service directory returns a populated table on success")
-    {
-        REQUIRE_FALSE(db.service_directory().empty());
-    }
-    SECTION("service directory returns an empty table on failure")
-    {
-        REQUIRE(no_schema_db.service_directory().empty());
-    }
-}
+    SQLite_DB(TEST_DB, CHOCAN_SCHEMA).backup_to(file);
 
-TEST_CASE("Retrieving all Provider Accounts", "[get_provider_accounts], [sqlite_db]")
-{
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
-    SQLite_DB no_schema_db(TEST_DB);
+    SQLite_DB terminal(file);
+    SQLite_DB manager(file);
 
-    SECTION("get_provider_accounts from a populated db returns a non-empty list of all provider accounts")
-    {
-        REQUIRE(db.get_provider_accounts().size() > 0);
-    }
-    SECTION("get_provider_accounts from an empty db returns a empty list")
+    Account jane = terminal.get_account(321321321).value();
+
+    REQUIRE(terminal.member_status(321321321).value() == Account_Status::Suspended);
+    REQUIRE(terminal.member_status(555555555).error() == Error_Code::Not_Found);
+
+    SECTION("Accounts created or reinstated by another connection are seen once the index is refreshed")
     {
-        REQUIRE(no_schema_db.get_provider_accounts().empty());
-    }
-}
+        manager.create_account(Account(jane.name(), jane.address(), Member(), 321321321, Mock_DB().get_db_key()));
+        manager.create_account(Account(jane.name(), jane.address(), Member(), 555555555, Mock_DB().get_db_key()));
 
-TEST_CASE("Retrieving Transaction data", "[get_transactions], [sqlite_db]")
-{
-    SQLite_DB db(TEST_DB, CHOCAN_SCHEMA);
+        REQUIRE(terminal.member_status(321321321).value() == Account_Status::Suspended);
 
-    Account member   = db.get_member_account(123123123).value();
-    Account provider = db.get_provider_account(987654321).value();
-    Account manager  = db.get_account(123456789).value();
+        terminal.set_id_index_refresh(std::chrono::milliseconds(0));
 
-    SECTION("Retrieving all transactions from a populated DB returns a non-empty list of transactions")
-    {
-        REQUIRE(db.get_transactions(DateTime(0), DateTime::get_current_datetime()).size() > 0);
-    }
-    SECTION("If not transactions meet the date paramters the empty list is returnd")
-    {
-        REQUIRE(db.get_transactions(DateTime(0), DateTime(0)).empty());
-    }
-    SECTION("Providing a provider account will retrieve transactions relevant to that account")
-    {
-        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
-                                                                     , DateTime::get_current_datetime()
-                                                                     , provider );
-        REQUIRE_FALSE(transactions.empty());
-        for (const auto& transaction : transactions)
-        {
-            REQUIRE(transaction.provider() == provider);
-        }
+        REQUIRE(terminal.member_status(321321321).value() == Account_Status::Valid);
+        REQUIRE(terminal.member_status(555555555).value() == Account_Status::Valid);
     }
-    SECTION("Providing a member account will retrieve transactions relevant to that account")
+    SECTION("Lookups within the refresh interval do not query the store")
     {
-        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
-                                                                     , DateTime::get_current_datetime()
-                                                                     , member );
-        REQUIRE_FALSE(transactions.empty());
-        for (const auto& transaction : transactions)
+        auto calls = [&terminal]()
         {
-            REQUIRE(transaction.member() == member);
-        }
+            unsigned long total = 0;
+            for(const auto& shape : terminal.query_metrics().stats()) { total += shape.second.calls; }
+            return total;
+        };
+        unsigned long before = calls();
+
+        REQUIRE(terminal.member_status(321321321).value() == Account_Status::Suspended);
+        REQUIRE(terminal.member_status(123451234).error() == Error_Code::Wrong_Type);
+        REQUIRE(terminal.member_status(555555555).error() == Error_Code::Not_Found);
+        REQUIRE_FALSE(terminal.id_index().exists(555555555));
+
+        REQUIRE(calls() == before);
     }
-    SECTION("Providing a manager account will retrieve all transactions")
+    SECTION("Writes through the connection keep its index current without a rebuild")
     {
-        Data_Gateway::Transactions all_transactions = db.get_transactions( DateTime(0)
-                                                                         , DateTime::get_current_datetime() );
+        terminal.create_account(Account(jane.name(), jane.address(), Member(), 555555555, Mock_DB().get_db_key()));
 
-        Data_Gateway::Transactions transactions = db.get_transactions( DateTime(0)
-                                                                     , DateTime::get_current_datetime()
-                                                                     , manager );
-        REQUIRE(all_transactions.size() == transactions.size());
+        REQUIRE(terminal.id_index().version() == terminal.accounts_version());
+        REQUIRE(terminal.member_status(555555555).value() == Account_Status::Valid);
     }
+    std::remove(file);
 }
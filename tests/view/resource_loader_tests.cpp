@@ -0,0 +1,154 @@
+/*
+
+File: resource_loader_tests.cpp
+
+Brief: Unit tests for resource table memoization
+
+Authors: Daniel Mendez
+         Alex Salazar
+         Arman Alauizadeh
+         Alexander DuPree
+         Kyle Zalewski
+         Dominique Moore
+
+https://github.com/AlexanderJDupree/ChocAn
+
+*/
+
+#include <memory>
+#include <catch.hpp>
+#include <ChocAn/data/mock_db.hpp>
+#include <ChocAn/view/resource_loader.hpp>
+
+TEST_CASE("Memoizing resource tables", "[memoize], [resource_loader]")
+{
+    Resource_Loader loader;
+
+    unsigned builds = 0;
+    auto build = [&]() -> Resource_Loader::Resource_Table
+    {
+        ++builds;
+        return { { "state_name", "Summary Report" } };
+    };
+
+    auto source = std::make_shared<const int>(1);
+
+    SECTION("A table is built once while its source is unchanged")
+    {
+        loader.memoize(source, build);
+        loader.memoize(source, build);
+
+        REQUIRE(builds == 1);
+        REQUIRE(loader.memoize(source, build).at("state_name") == "Summary Report");
+    }
+    SECTION("A new source rebuilds the table")
+    {
+        loader.memoize(source, build);
+        loader.memoize(std::make_shared<const int>(1), build);
+
+        REQUIRE(builds == 2);
+    }
+    SECTION("A released source is never matched, even if its address is reused")
+    {
+        loader.memoize(source, build);
+        source.reset();
+        source = std::make_shared<const int>(2);
+        loader.memoize(source, build);
+
+        REQUIRE(builds == 2);
+    }
+}
+
+TEST_CASE("Loading a page of a report", "[view_report], [resource_loader]")
+{
+    Mock_DB db;
+
+    Data_Gateway::Transactions transactions;
+    Data_Gateway::Transactions filed = db.get_transactions(DateTime(0), DateTime::get_current_datetime());
+    while(transactions.size() < 25) { transactions.push_back(filed[transactions.size() % filed.size()]); }
+
+    View_Report view { std::make_shared<const ChocAn_Report>(Member_Report(db.get_account(6789).value(), transactions)) };
+
+    auto rows = [](const std::string& activity)
+    {
+        size_t count = 0;
+        for(size_t pos = activity.find("Service Date"); pos != std::string::npos; pos = activity.find("Service Date", pos + 1))
+        {
+            ++count;
+        }
+        return count;
+    };
+
+    SECTION("Only the rows on the visible page are rendered")
+    {
+        Application_State state = view;
+        Resource_Loader loader(state);
+
+        REQUIRE(rows(loader.table.at("account_activity")) == View_Report::page_size);
+        REQUIRE(loader.table.at("page").find("Page 1 of 2") != std::string::npos);
+
+        view.page = 1;
+        Application_State next_page = view;
+        loader.load(next_page);
+
+        REQUIRE(rows(loader.table.at("account_activity")) == 5);
+        REQUIRE(loader.table.at("page").find("Page 2 of 2") != std::string::npos);
+    }
+    SECTION("Reports that fit on one page have no paging controls")
+    {
+        Application_State state = View_Report { std::make_shared<const ChocAn_Report>(Member_Report(db.get_account(6789).value(), filed)) };
+        Resource_Loader loader(state);
+
+        REQUIRE(loader.table.at("page").empty());
+    }
+}
+
+TEST_CASE("Loading service directory resources", "[resource_loader]")
+{
+    Mock_DB db;
+
+    Application_State state = View_Service_Directory { db.service_catalog() };
+
+    Resource_Loader loader;
+    loader.load(state);
+
+    SECTION("Reloading the same catalog reuses the rendered directory")
+    {
+        std::string directory = loader.table.at("directory");
+
+        loader.update();
+
+        REQUIRE(loader.table.at("directory") == directory);
+        REQUIRE(loader.table.at("state_name") == "Service Directory");
+    }
+}
+
+TEST_CASE("Resource tables are built in the loader's arena", "[arena], [resource_loader]")
+{
+    Mock_DB db;
+
+    Application_State login     = Login { "Invalid login" };
+    Application_State directory = View_Service_Directory { db.service_catalog() };
+
+    Resource_Loader loader(login);
+
+    SECTION("Each load rebuilds the table in the arena")
+    {
+        REQUIRE(loader.table.get_allocator().resource() == &loader.arena);
+        REQUIRE(loader.table.at("login_status") == "Invalid login");
+
+        loader.load(directory);
+
+        REQUIRE(loader.table.get_allocator().resource() == &loader.arena);
+        REQUIRE(loader.table.at("state_name") == "Service Directory");
+    }
+    SECTION("Memoized tables are kept off the arena so they survive its reset")
+    {
+        loader.load(directory);
+        loader.load(login);
+        loader.load(directory);
+
+        REQUIRE(loader.memo_table.get_allocator().resource() != &loader.arena);
+        REQUIRE(loader.table.at("directory") == loader.memo_table.at("directory"));
+    }
+}